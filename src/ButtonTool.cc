@@ -63,8 +63,8 @@ void ButtonTool::renderTheme(int alpha) {
         m_cache_pm = 0;
         btn.setBackgroundColor(theme()->texture().color());
     } else {
-        m_cache_pm = m_image_ctrl.renderImage(width(), height(),
-                                              theme()->texture(), orientation());
+        m_cache_pm = m_image_ctrl.renderBackground(width(), height(),
+                                                   theme()->texture(), orientation());
         btn.setBackgroundPixmap(m_cache_pm);
     }
     if (old_pm)
@@ -75,8 +75,8 @@ void ButtonTool::renderTheme(int alpha) {
         m_cache_pressed_pm = 0;
         btn.setPressedColor(static_cast<const ButtonTheme &>(*theme()).pressed().color());
     } else {
-        m_cache_pressed_pm = m_image_ctrl.renderImage(width(), height(),
-                                                      static_cast<const ButtonTheme &>(*theme()).pressed(), orientation());
+        m_cache_pressed_pm = m_image_ctrl.renderBackground(width(), height(),
+                                                           static_cast<const ButtonTheme &>(*theme()).pressed(), orientation());
         btn.setPressedPixmap(m_cache_pressed_pm);
     }
 
@@ -26,6 +26,8 @@
 
 #include "FbTk/Signal.hh"
 
+#include <list>
+
 class BScreen;
 class FluxboxWindow;
 class Focusable;
@@ -33,6 +33,7 @@
 #include "FbTk/App.hh"
 #include "FbTk/stringstream.hh"
 #include "FbTk/STLUtil.hh"
+#include "FbTk/Stats.hh"
 
 #include <fstream>
 #include <string>
@@ -304,6 +305,9 @@ string ClientPattern::toString() const {
 
 // does this client match this pattern?
 bool ClientPattern::match(const Focusable &win) const {
+
+    FBTK_STATS_TIME("ClientPattern::match");
+
     if (m_matchlimit != 0 && m_nummatches >= m_matchlimit)
         return false; // already matched out
 
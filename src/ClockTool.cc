@@ -54,6 +54,11 @@ int showSeconds(const std::string& fmt) {
                     fmt, '%', SWITCHES_SECONDS, sizeof(SWITCHES_SECONDS), 0) != std::string::npos;
 }
 
+/// the clock wakes up this long after the second or minute changed, so
+/// a timer firing a bit early doesn't find the old time and has to wait
+/// once more
+const uint64_t TIMER_SLACK = 10 * FbTk::FbTime::IN_MILLISECONDS;
+
 uint64_t calcNextTimeout(const std::string& fmt) {
 
     uint64_t now = FbTk::FbTime::system();
@@ -61,9 +66,37 @@ uint64_t calcNextTimeout(const std::string& fmt) {
     if (!showSeconds(fmt)) { // microseconds till next full minute
          unit *= 60L;
     }
-    return FbTk::FbTime::remainingNext(now, unit);
+    return FbTk::FbTime::remainingNext(now, unit) + TIMER_SLACK;
+}
+
+// we replace only numbers with zeros because everything else should be
+// relatively static. if we replace all text with zeros then widths of
+// proportional fonts with some strftime formats will be considerably off.
+FbTk::FbString sizingText(const FbTk::FbString &t) {
+
+    const size_t s = t.size();
+    FbTk::FbString text(s + 2, '0'); // +2 for extra padding
+
+    for (size_t i = 0; i < s; ++i) {
+        if (!isdigit(t[i]))
+            text[i] = t[i];
+    }
+    return text;
+}
+
+bool isAscii(const char *str) {
+    for (; *str != 0; ++str) {
+        if (static_cast<unsigned char>(*str) >= 0x80)
+            return false;
+    }
+    return true;
 }
 
+#ifdef HAVE_LOCALTIME_R
+/// minute the timezone was looked up last
+time_t s_tz_minute = 0;
+#endif // HAVE_LOCALTIME_R
+
 
 } // end of anonymous namespace
 
@@ -212,19 +245,8 @@ void ClockTool::setTimeFormat(const std::string &format) {
 
 void ClockTool::themeReconfigured() {
 
-    // we replace only numbers with zeros because everything else should be
-    // relatively static. if we replace all text with zeros then widths of
-    // proportional fonts with some strftime formats will be considerably off.
-
-    const FbTk::FbString& t = m_button.text().logical();
-    const size_t s = t.size();
-    size_t i;
-    FbTk::FbString text(s + 2, '0'); // +2 for extra padding
-
-    for (i = 0; i < s; ++i) {
-        if (!isdigit(t[i]))
-            text[i] = t[i];
-    }
+    m_sizing_text = sizingText(m_button.text().logical());
+    const FbTk::FbString &text = m_sizing_text;
 
     unsigned int new_width = m_button.width();
     unsigned int new_height = m_button.height();
@@ -272,8 +294,21 @@ void ClockTool::updateTime() {
         struct tm*      type;
         FbTk::FbString  text;
 
+#ifdef HAVE_LOCALTIME_R
+        struct tm       local;
+
+        // localtime() looks the timezone up on each call, which
+        // means a stat() of /etc/localtime. once a minute will do.
+        if (t / 60 != s_tz_minute) {
+            tzset();
+            s_tz_minute = t / 60;
+        }
+        if ((type = localtime_r(&t, &local)) == 0)
+            goto restart_timer;
+#else
         if ((type = localtime(&t)) == 0)
             goto restart_timer;
+#endif // HAVE_LOCALTIME_R
 
 #ifdef HAVE_STRFTIME
 
@@ -281,7 +316,11 @@ void ClockTool::updateTime() {
         if (len == 0)
             goto restart_timer;
 
-        text = m_stringconvertor.recode(buf);
+        // only names of days or months might need to be converted
+        if (isAscii(buf))
+            text = buf;
+        else
+            text = m_stringconvertor.recode(buf);
         if (m_button.text().logical() == text) {
             goto restart_timer;
         }
@@ -291,7 +330,9 @@ void ClockTool::updateTime() {
 #endif // HAVE_STRFTIME
 
         m_button.setText(text);
-        themeReconfigured();
+        // the size stays the same as long as only digits change
+        if (sizingText(text) != m_sizing_text)
+            themeReconfigured();
     }
 
 restart_timer:
@@ -309,8 +350,8 @@ void ClockTool::reRender() {
         m_screen.imageControl().removeImage(m_pixmap);
 
     if (m_theme->texture().usePixmap()) {
-        m_pixmap = m_screen.imageControl().renderImage(width(), height(),
-                                                       m_theme->texture(), orientation());
+        m_pixmap = m_screen.imageControl().renderBackground(width(), height(),
+                                                            m_theme->texture(), orientation());
         m_button.setBackgroundPixmap(m_pixmap);
     } else {
         m_pixmap = 0;
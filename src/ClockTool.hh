@@ -81,6 +81,7 @@ private:
 
     FbTk::Resource<std::string>         m_timeformat;
     FbTk::StringConvertor               m_stringconvertor;
+    FbTk::FbString                      m_sizing_text; ///< text the size was calculated for
     FbTk::SignalTracker                 m_tracker;
 };
 
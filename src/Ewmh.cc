@@ -61,244 +61,6 @@ using std::list;
 #endif
 
 
-namespace {
-
-/* From Extended Window Manager Hints, draft 1.3:
- *
- * _NET_WM_ICON CARDINAL[][2+n]/32
- *
- * This is an array of possible icons for the client. This specification does
- * not stipulate what size these icons should be, but individual desktop
- * environments or toolkits may do so. The Window Manager MAY scale any of
- * these icons to an appropriate size.
- *
- * This is an array of 32bit packed CARDINAL ARGB with high byte being A, low
- * byte being B. The first two cardinals are width, height. Data is in rows,
- * left to right and top to bottom. 
- *
- ***
- *
- * NOTE: the returned data for XA_CARDINAL is long if the rfmt equals
- * 32. sizeof(long) on 64bit machines is 8. to quote from
- * "man XGetWindowProperty":
- *
- *    If the returned format is 32, the property data will be stored as 
- *    an array of longs (which in a 64-bit application will be 64-bit 
- *    values that are padded in the upper 4 bytes).
- *
- * this is especially true on 64bit machines when some of the clients
- * (eg: tvtime, konqueror3) have problems to feed in the right data
- * into the _NET_WM_ICON property. we faced some segfaults because
- * width and height were not quite right because of ignoring 64bit
- * behaviour on client side.
- *
- * TODO: maybe move the pixmap-creation code to FbTk? */
-void extractNetWmIcon(Atom net_wm_icon, WinClient& winclient) {
-
-    typedef std::pair<int, int> Size;
-    typedef std::map<Size, const unsigned long*> IconContainer;
-
-    unsigned long* raw_data = 0;
-    unsigned long nr_icon_data = 0;
-
-    {
-        Atom rtype;
-        int rfmt;
-        unsigned long nr_read;
-        unsigned long nr_bytes_left;
-
-        // no data or no _NET_WM_ICON
-        if (! winclient.property(net_wm_icon, 0L, 0L, False, XA_CARDINAL,
-                                 &rtype, &rfmt, &nr_read, &nr_bytes_left,
-                                 reinterpret_cast<unsigned char**>(&raw_data)) || nr_bytes_left == 0) {
-
-            if (raw_data)
-                XFree(raw_data);
-
-            return;
-        }
-
-        // actually there is some data in _NET_WM_ICON
-        nr_icon_data = nr_bytes_left / sizeof(CARD32);
-
-        fbdbg << "extractNetWmIcon: " << winclient.title().logical() << "\n";
-        fbdbg << "nr_icon_data: " << nr_icon_data << "\n";
-
-        // read all the icons stored in _NET_WM_ICON
-        if (raw_data)
-            XFree(raw_data);
-
-        // something went wrong
-        if (!winclient.property(net_wm_icon, 0L, nr_icon_data, False, XA_CARDINAL,
-                           &rtype, &rfmt, &nr_read, &nr_bytes_left,
-                           reinterpret_cast<unsigned char**>(&raw_data))) {
-
-            return;
-        }
-
-        fbdbg << "nr_read: " << nr_read << "|" << nr_bytes_left << "\n";
-
-    }
-
-    IconContainer icon_data; // stores all available data, sorted by size (width x height)
-    unsigned long width;
-    unsigned long height;
-
-    // analyze the available icons
-    //
-    // check also for invalid values coming in from "bad" applications
-    unsigned long i;
-    for (i = 0; i + 2 < nr_icon_data; i += width * height ) {
-
-        width = raw_data[i++];
-        if (width >= nr_icon_data) {
-
-            fbdbg << "Ewmh.cc extractNetWmIcon found strange _NET_WM_ICON width (" 
-                  << width << ") for " << winclient.title().logical() << "\n";
-            break;
-        }
-
-        height = raw_data[i++];
-        if (height >= nr_icon_data) {
-
-            fbdbg << "Ewmh.cc extractNetWmIcon found strange _NET_WM_ICON height (" 
-                  << height << ") for " << winclient.title().logical() << "\n";
-
-            break;
-        }
-
-        // strange values stored in the NETWM_ICON
-        if (i + width * height > nr_icon_data) {
-            fbdbg << "Ewmh.cc extractNetWmIcon found strange _NET_WM_ICON dimensions (" 
-
-                  << width << "x" << height << ")for " << winclient.title().logical() << "\n";
-
-            break;
-        }
-
-        icon_data[Size(width, height)] = &raw_data[i];
-    }
-
-    // no valid icons found at all
-    if (icon_data.empty()) {
-        XFree(raw_data);
-        return;
-    }
-
-    Display* dpy = FbTk::App::instance()->display();
-    int scrn = winclient.screen().screenNumber();
-
-    // the icon will not be used by the client but by
-    // 'menu', 'iconbar', 'titlebar'. all these entities
-    // are created based upon the rootwindow and
-    // the default depth. if we would use winclient.depth()
-    // and winclient.drawable() here we might get into trouble
-    // (xfce4-terminal, skype .. 32bit visuals vs 24bit fluxbox
-    // entities)
-    Drawable parent = winclient.screen().rootWindow().drawable();
-    unsigned int depth = DefaultDepth(dpy, scrn);
-
-    // pick the smallest icon size atm
-    // TODO: find a better criteria
-    width = icon_data.begin()->first.first;
-    height = icon_data.begin()->first.second;
-
-    // tmp image for the pixmap
-    XImage* img_pm = XCreateImage(dpy, DefaultVisual(dpy, scrn), depth,
-                                  ZPixmap,
-                                  0, NULL, width, height, 32, 0);
-    if (!img_pm) {
-        XFree(raw_data);
-        return;
-    }
-
-    // tmp image for the mask
-    XImage* img_mask = XCreateImage(dpy, DefaultVisual(dpy, scrn), 1,
-                                  XYBitmap,
-                                  0, NULL, width, height, 32, 0);
-
-    if (!img_mask) {
-        XFree(raw_data);
-        XDestroyImage(img_pm);
-        return;
-    }
-
-    // allocate some memory for the icons at client side
-    img_pm->data = static_cast<char*>(malloc(img_pm->bytes_per_line * height));
-    img_mask->data = static_cast<char*>(malloc(img_mask->bytes_per_line * height));
-
-
-    const unsigned long* src = icon_data.begin()->second;
-    unsigned int rgba;
-    unsigned long pixel;
-    unsigned long x;
-    unsigned long y;
-    unsigned char r, g, b, a;
-
-    for (y = 0; y < height; y++) {
-        for (x = 0; x < width; x++, src++) {
-
-            rgba = *src; // use only 32bit
-
-            a = ( rgba & 0xff000000 ) >> 24;
-            r = ( rgba & 0x00ff0000 ) >> 16;
-            g = ( rgba & 0x0000ff00 ) >> 8;
-            b = ( rgba & 0x000000ff );
-
-            // 15 bit display, 5R 5G 5B
-            if (img_pm->red_mask == 0x7c00
-                && img_pm->green_mask == 0x03e0
-                && img_pm->blue_mask == 0x1f) {
-
-                pixel = ((r << 7) & 0x7c00) | ((g << 2) & 0x03e0) | ((b >> 3) & 0x001f);
-
-            // 16 bit display, 5R 6G 5B
-            } else if (img_pm->red_mask == 0xf800
-                       && img_pm->green_mask == 0x07e0
-                       && img_pm->blue_mask == 0x1f) {
-
-                pixel = ((r << 8) & 0xf800) | ((g << 3) & 0x07e0) | ((b >> 3) & 0x001f);
-
-            // 24/32 bit display, 8R 8G 8B
-            } else if (img_pm->red_mask == 0xff0000
-                       && img_pm->green_mask == 0xff00
-                       && img_pm->blue_mask == 0xff) {
-
-                pixel = rgba & 0x00ffffff;
-
-            } else {
-                pixel = 0;
-            }
-
-            // transfer rgb data
-            XPutPixel(img_pm, x, y, pixel);
-
-            // transfer mask data
-            XPutPixel(img_mask, x, y, a > 127 ? 0 : 1);
-        }
-    }
-
-    // the final icon
-    FbTk::PixmapWithMask icon;
-    icon.pixmap() = FbTk::FbPixmap(parent, width, height, depth);
-    icon.mask() = FbTk::FbPixmap(parent, width, height, 1);
-
-    FbTk::GContext gc_pm(icon.pixmap());
-    FbTk::GContext gc_mask(icon.mask());
-
-    XPutImage(dpy, icon.pixmap().drawable(), gc_pm.gc(), img_pm, 0, 0, 0, 0, width, height);
-    XPutImage(dpy, icon.mask().drawable(), gc_mask.gc(), img_mask, 0, 0, 0, 0, width, height);
-
-    XDestroyImage(img_pm);   // frees img_pm->data as well
-    XDestroyImage(img_mask); // frees img_mask->data as well
-
-    XFree(raw_data);
-
-    winclient.setIcon(icon);
-}
-
-} // end anonymous namespace
-
 class Ewmh::EwmhAtoms {
 public:
 
@@ -631,8 +393,7 @@ void Ewmh::setupClient(WinClient &winclient) {
     unsigned char* data = 0;
 
 
-    extractNetWmIcon(m_net->wm_icon, winclient);
-
+    winclient.updateNetWmIcon();
 
     /* From Extended Window Manager Hints, draft 1.3:
      *
@@ -1284,7 +1045,7 @@ bool Ewmh::propertyNotify(WinClient &winclient, Atom the_property) {
         // we don't use icon title, since we don't show icons
         return true;
     } else if (the_property == m_net->wm_icon) {
-        extractNetWmIcon(m_net->wm_icon, winclient);
+        winclient.updateNetWmIcon();
         return true;
     }
 
@@ -29,17 +29,22 @@
 #include "Window.hh"
 #include "Keys.hh"
 #include "MenuCreator.hh"
+#include "Launcher.hh"
+#include "IPCServer.hh"
 
 #include "FbTk/Theme.hh"
 #include "FbTk/Menu.hh"
 #include "FbTk/CommandParser.hh"
 #include "FbTk/StringUtil.hh"
 #include "FbTk/stringstream.hh"
+#include "FbTk/FbTime.hh"
+#include "FbTk/Stats.hh"
 
 #include <sys/types.h>
 #include <unistd.h>
 
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <set>
 #include <cstdlib>
@@ -121,10 +126,6 @@ int ExecuteCmd::run() {
 
     return spawnlp(P_NOWAIT, comspec, comspec, "/c", m_cmd.c_str(), static_cast<void*>(NULL));
 #else
-    pid_t pid = fork();
-    if (pid)
-        return pid;
-
     // 'display' is given as 'host:number.screen'. we want to give the
     // new app a good home, so we remove '.screen' from what is given
     // us from the xserver and replace it with the screen_num of the Screen
@@ -147,19 +148,7 @@ int ExecuteCmd::run() {
     display += '.';
     display += FbTk::StringUtil::number2String(screen_num);
 
-    FbTk::App::setenv("DISPLAY", display.c_str());
-
-    // get shell path from the environment
-    // this process exits immediately, so we don't have to worry about memleaks
-    const char *shell = getenv("SHELL");
-    if (!shell)
-        shell = "/bin/sh";
-
-    setsid();
-    execl(shell, shell, "-c", m_cmd.c_str(), static_cast<void*>(NULL));
-    exit(EXIT_SUCCESS);
-
-    return pid; // compiler happy -> we are happy ;)
+    return Launcher::spawn(m_cmd, display, screen_num);
 #endif
 }
 
@@ -591,12 +580,60 @@ void ClientPatternTestCmd::execute() {
     }
 
 
-    // write result to _FLUXBOX_ACTION_RESULT property
+    // the result goes to IPC clients directly, and to the
+    // _FLUXBOX_ACTION_RESULT property for fluxbox-remote
+    IPCServer::output(result);
     for (screen = screens.begin(); screen != screens.end(); screen++) {
         (*screen)->rootWindow().changeProperty(atom_fbcmd_result, atom_utf8, 8,
             PropModeReplace, (unsigned char*)result.c_str(), result.size());
     }
 }
 
+#ifdef USE_STATS
+
+REGISTER_COMMAND_PARSER(dumpstats, DumpStatsCmd::parse, void);
+
+FbTk::Command<void> *DumpStatsCmd::parse(const string &command,
+        const string &args, bool trusted) {
+    if (!trusted && !args.empty())
+        return 0;
+    return new DumpStatsCmd(args);
+}
+
+void DumpStatsCmd::execute() {
+
+    FbTk_ostringstream stats;
+    FbTk::Stats::dump(stats);
+
+    const uint64_t now = FbTk::FbTime::mono();
+    const Launcher::Children &children = Launcher::children();
+    stats << "# child" << std::setw(35) << "pid" << std::setw(10) << "seconds"
+          << "  command\n";
+    for (size_t i = 0; i < children.size(); ++i) {
+        stats << std::setw(42) << children[i].pid
+              << std::setw(10) << (now - children[i].start) / FbTk::FbTime::IN_SECONDS
+              << "  " << children[i].command << "\n";
+    }
+
+    if (!m_filename.empty()) {
+        ofstream out(FbTk::StringUtil::expandFilename(m_filename).c_str());
+        if (!out) {
+            std::cerr << "DumpStats: can't write " << m_filename << endl;
+            return;
+        }
+        out << stats.str();
+    } else if (!IPCServer::output(stats.str())) {
+        std::cerr << stats.str();
+    }
+}
+
+REGISTER_COMMAND(resetstats, FbCommands::ResetStatsCmd, void);
+
+void ResetStatsCmd::execute() {
+    FbTk::Stats::reset();
+}
+
+#endif // USE_STATS
+
 
 } // end namespace FbCommands
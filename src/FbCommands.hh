@@ -228,6 +228,26 @@ private:
     std::string m_args;
 };
 
+#ifdef USE_STATS
+/// writes the profiling counters and histograms
+class DumpStatsCmd: public FbTk::Command<void> {
+public:
+    explicit DumpStatsCmd(const std::string &filename): m_filename(filename) { }
+    void execute();
+    /// writing to a file is only allowed if 'trusted'
+    static FbTk::Command<void> *parse(const std::string &command,
+                                      const std::string &args, bool trusted);
+private:
+    std::string m_filename;
+};
+
+/// sets the profiling counters and histograms back to zero
+class ResetStatsCmd: public FbTk::Command<void> {
+public:
+    void execute();
+};
+#endif // USE_STATS
+
 } // end namespace FbCommands
 
 #endif // FBCOMMANDS_HH
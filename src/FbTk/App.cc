@@ -65,6 +65,7 @@ App::~App() {
     if (m_display != 0) {
 
         Font::shutdown();
+        Image::shutdown();
 
         XCloseDisplay(m_display);
         m_display = 0;
@@ -21,7 +21,7 @@
 
 #include "AutoReloadHelper.hh"
 
-#include "FileUtil.hh"
+#include "FileWatcher.hh"
 #include "StringUtil.hh"
 
 namespace FbTk {
@@ -29,11 +29,11 @@ namespace FbTk {
 void AutoReloadHelper::checkReload() {
     if (!m_reload_cmd.get())
         return;
-    TimestampMap::const_iterator it = m_timestamps.begin();
-    TimestampMap::const_iterator it_end = m_timestamps.end();
+    FileWatcher &watcher = FileWatcher::instance();
+    SerialMap::const_iterator it = m_serials.begin();
+    SerialMap::const_iterator it_end = m_serials.end();
     for (; it != it_end; ++it) {
-        if (FileUtil::getLastStatusChangeTimestamp(it->first.c_str()) !=
-            it->second) {
+        if (watcher.serial(it->first) != it->second) {
             reload();
             return;
         }
@@ -52,13 +52,13 @@ void AutoReloadHelper::addFile(const std::string& file) {
     if (file.empty())
         return;
     std::string expanded_file = StringUtil::expandFilename(file);
-    m_timestamps[expanded_file] = FileUtil::getLastStatusChangeTimestamp(expanded_file.c_str());
+    m_serials[expanded_file] = FileWatcher::instance().watch(expanded_file);
 }
 
 void AutoReloadHelper::reload() {
     if (!m_reload_cmd.get())
         return;
-    m_timestamps.clear();
+    m_serials.clear();
     addFile(m_main_file);
     m_reload_cmd->execute();
 }
@@ -24,7 +24,6 @@
 
 #include <map>
 #include <string>
-#include <sys/types.h>
 
 #include "Command.hh"
 #include "RefCount.hh"
@@ -45,8 +44,9 @@ private:
     RefCount<Command<void> > m_reload_cmd;
     std::string m_main_file;
 
-    typedef std::map<std::string, time_t> TimestampMap;
-    TimestampMap m_timestamps;
+    /// serials of the files as given by FileWatcher
+    typedef std::map<std::string, unsigned long> SerialMap;
+    SerialMap m_serials;
 };
 
 } // end namespace FbTk
@@ -402,6 +402,12 @@ void Container::repositionItems() {
         translatePosition(m_orientation, tmpx, tmpy, tmpw, tmph, borderW);
         translateSize(m_orientation, tmpw, tmph);
 
+        // only items which are not in place yet are touched; the others
+        // don't need to be drawn again
+        if ((*it)->x() == tmpx && (*it)->y() == tmpy &&
+            (*it)->width() == tmpw && (*it)->height() == tmph)
+            continue;
+
         // resize each clients including border in size
         (*it)->moveResize(tmpx, tmpy,
                           tmpw, tmph);
@@ -399,8 +399,12 @@ bool FbPixmap::rootwinPropertyNotify(int screen_num, Atom atom) {
                     root_pm = (Pixmap) (*data);
                 }
                 XFree(data);
-                if (root_pm != None)
-                    return setRootPixmap(screen_num, root_pm);
+                if (root_pm != None) {
+                    // same pixmap? it might have been drawn to
+                    if (!setRootPixmap(screen_num, root_pm))
+                        FbWindow::updatedAlphaBackground(screen_num);
+                    return true;
+                }
             }
             return false;
         }
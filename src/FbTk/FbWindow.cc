@@ -197,19 +197,6 @@ void FbWindow::updateBackground(bool only_if_alpha) {
 
         FbPixmap newpm = FbPixmap(*this, width(), height(), depth());
         free_newbg = true; // newpm gets released to newbg at end of block
-        GC gc = XCreateGC(display(), window(), 0, 0);
-
-        if (m_lastbg_pm == None && m_lastbg_color_set) {
-            XSetForeground(display(), gc, m_lastbg_color);
-            newpm.fillRectangle(gc, 0, 0, width(), height());
-        } else {
-            // copy from window if no color and no bg...
-            newpm.copyArea((m_lastbg_pm == None)?drawable():m_lastbg_pm, gc, 0, 0, 0, 0, width(), height());
-        }
-        XFreeGC(display(), gc);
-
-        if (alpha != 255)
-            m_transparent->setDest(newpm.drawable(), screenNumber());
 
         // get root position
 
@@ -226,18 +213,46 @@ void FbWindow::updateBackground(bool only_if_alpha) {
             }
         }
 
-        // render background image from root pos to our window
-        if (alpha != 255)
-            m_transparent->render(root_x, root_y,
-                                  0, 0,
-                                  width(), height());
+        // the background only depends on these, so if nothing moved
+        // (e.g. just the text of a button changed) the last one is reused
+        Pixmap bg_pm = m_lastbg_pm;
+        unsigned long bg_color = (m_lastbg_pm == None ? m_lastbg_color : 0);
+
+        if (alpha == 255 ||
+            !m_transparent->copyRendered(newpm, root_x, root_y, bg_pm, bg_color)) {
+
+            GC gc = XCreateGC(display(), window(), 0, 0);
+
+            if (m_lastbg_pm == None && m_lastbg_color_set) {
+                XSetForeground(display(), gc, m_lastbg_color);
+                newpm.fillRectangle(gc, 0, 0, width(), height());
+            } else if (m_lastbg_pm != None) {
+                // tile it like the server would, the background might be
+                // a strip from ImageControl::renderBackground()
+                XSetTile(display(), gc, m_lastbg_pm);
+                XSetFillStyle(display(), gc, FillTiled);
+                newpm.fillRectangle(gc, 0, 0, width(), height());
+            } else {
+                // copy from window if no color and no bg...
+                newpm.copyArea(drawable(), gc, 0, 0, 0, 0, width(), height());
+            }
+            XFreeGC(display(), gc);
+
+            // render background image from root pos to our window
+            if (alpha != 255) {
+                m_transparent->setDest(newpm.drawable(), screenNumber());
+                m_transparent->render(root_x, root_y,
+                                      0, 0,
+                                      width(), height());
+                m_transparent->freeDest(); // it's only temporary, don't leave it hanging around
+                m_transparent->keepRendered(newpm, root_x, root_y, bg_pm, bg_color);
+            }
+        }
 
         // render any foreground items
         if (m_renderer)
             m_renderer->renderForeground(*this, newpm);
 
-        if (alpha != 255)
-            m_transparent->freeDest(); // it's only temporary, don't leave it hanging around
         newbg = newpm.release();
     }
 
@@ -521,7 +536,7 @@ FbTk::FbString FbWindow::textProperty(Atom prop,bool*exists) const {
     static const Atom utf8string = XInternAtom(display(), "UTF8_STRING", False);
 
     if (exists) *exists=false;
-    if (XGetTextProperty(display(), window(), &text_prop, prop) == 0 || text_prop.value == 0 || text_prop.nitems == 0) {
+    if (!textProperty(window(), prop, text_prop) || text_prop.value == 0 || text_prop.nitems == 0) {
         return "";
     }
 
@@ -558,7 +573,7 @@ FbTk::FbString FbWindow::textProperty(Atom prop,bool*exists) const {
     return ret;
 }
 
-bool FbWindow::property(Atom prop,
+bool FbWindow::property(Window win, Atom prop,
                         long long_offset, long long_length,
                         bool do_delete,
                         Atom req_type,
@@ -566,8 +581,18 @@ bool FbWindow::property(Atom prop,
                         int *actual_format_return,
                         unsigned long *nitems_return,
                         unsigned long *bytes_after_return,
-                        unsigned char **prop_return) const {
-    if (XGetWindowProperty(display(), window(),
+                        unsigned char **prop_return) {
+    if (s_property_source != 0) {
+        if (do_delete)
+            s_property_source->invalidate(win, prop);
+        else if (s_property_source->property(win, prop, long_offset, long_length,
+                                             req_type, actual_type_return,
+                                             actual_format_return, nitems_return,
+                                             bytes_after_return, prop_return))
+            return true;
+    }
+
+    if (XGetWindowProperty(display(), win,
                            prop, long_offset, long_length, do_delete,
                            req_type, actual_type_return,
                            actual_format_return, nitems_return,
@@ -577,18 +602,67 @@ bool FbWindow::property(Atom prop,
     return false;
 }
 
+bool FbWindow::textProperty(Window win, Atom prop, XTextProperty &text_prop) {
+    Atom type;
+    int format;
+    unsigned long nitems, bytes_after;
+    unsigned char *data = 0;
+
+    text_prop.value = 0;
+    text_prop.encoding = None;
+    text_prop.format = 0;
+    text_prop.nitems = 0;
+
+    // same request as XGetTextProperty()
+    if (!property(win, prop, 0, 1000000L, False, AnyPropertyType,
+                  &type, &format, &nitems, &bytes_after, &data))
+        return false;
+
+    if (type == None) {
+        if (data)
+            XFree(data);
+        return false;
+    }
+
+    text_prop.value = data;
+    text_prop.encoding = type;
+    text_prop.format = format;
+    text_prop.nitems = nitems;
+    return true;
+}
+
+bool FbWindow::property(Atom prop,
+                        long long_offset, long long_length,
+                        bool do_delete,
+                        Atom req_type,
+                        Atom *actual_type_return,
+                        int *actual_format_return,
+                        unsigned long *nitems_return,
+                        unsigned long *bytes_after_return,
+                        unsigned char **prop_return) const {
+    return property(window(), prop, long_offset, long_length, do_delete,
+                    req_type, actual_type_return, actual_format_return,
+                    nitems_return, bytes_after_return, prop_return);
+}
+
 void FbWindow::changeProperty(Atom prop, Atom type,
                               int format,
                               int mode,
                               unsigned char *data,
                               int nelements) {
 
+    if (s_property_source)
+        s_property_source->invalidate(m_window, prop);
+
     XChangeProperty(display(), m_window, prop, type,
                     format, mode,
                     data, nelements);
 }
 
 void FbWindow::deleteProperty(Atom prop) {
+    if (s_property_source)
+        s_property_source->invalidate(m_window, prop);
+
     XDeleteProperty(display(), m_window, prop);
 }
 
@@ -703,6 +777,7 @@ void FbWindow::sendConfigureNotify(int x, int y,
 }
 
 FbWindow::FbWinList FbWindow::m_alpha_wins;
+FbWindow::PropertySource *FbWindow::s_property_source = 0;
 
 void FbWindow::addAlphaWin(FbWindow &win) {
     m_alpha_wins.insert(&win);
@@ -719,6 +794,8 @@ void FbWindow::updatedAlphaBackground(int screen) {
     FbWinList::iterator it_end = m_alpha_wins.end();
     for (; it != it_end; ++it) {
         if ((*it)->screenNumber() == screen) {
+            if ((*it)->m_transparent.get() != 0)
+                (*it)->m_transparent->forgetRendered();
             (*it)->updateBackground(false);
             (*it)->clear();
         }
@@ -25,6 +25,8 @@
 #include "FbDrawable.hh"
 #include "FbString.hh"
 
+#include <X11/Xutil.h>
+
 #include <memory>
 #include <string>
 #include <set>
@@ -150,6 +152,44 @@ public:
 
     void reparent(const FbWindow &parent, int x, int y, bool continuing = true);
 
+    /// Answers property requests without asking the server, e.g. from
+    /// replies which were requested in advance.
+    class PropertySource {
+    public:
+        virtual ~PropertySource() { }
+        /**
+           same as XGetWindowProperty() with do_delete = false
+           @return true if the request was answered, else the server is asked
+        */
+        virtual bool property(Window win, Atom property,
+                              long long_offset, long long_length,
+                              Atom req_type,
+                              Atom *actual_type_return,
+                              int *actual_format_return,
+                              unsigned long *nitems_return,
+                              unsigned long *bytes_after_return,
+                              unsigned char **prop_return) = 0;
+        /// the property was changed or deleted by us
+        virtual void invalidate(Window win, Atom property) = 0;
+    };
+
+    /// sets the source consulted first by property(), 0 for none
+    static void setPropertySource(PropertySource *source) { s_property_source = source; }
+    static PropertySource *propertySource() { return s_property_source; }
+
+    /// same as XGetWindowProperty(), but consults the property source first
+    static bool property(Window win, Atom property,
+                         long long_offset, long long_length,
+                         bool do_delete,
+                         Atom req_type,
+                         Atom *actual_type_return,
+                         int *actual_format_return,
+                         unsigned long *nitems_return,
+                         unsigned long *bytes_after_return,
+                         unsigned char **prop_return);
+    /// same as XGetTextProperty(), but goes through property()
+    static bool textProperty(Window win, Atom property, XTextProperty &text_prop);
+
     bool property(Atom property,
                   long long_offset, long long_length,
                   bool do_delete,
@@ -253,6 +293,8 @@ private:
 
     typedef std::set<FbWindow *> FbWinList;
     static FbWinList m_alpha_wins;
+
+    static PropertySource *s_property_source;
 };
 
 bool operator == (Window win, const FbWindow &fbwin);
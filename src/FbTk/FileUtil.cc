@@ -73,6 +73,21 @@ bool FileUtil::isExecutable(const char* filename) {
     ;
 }
 
+bool FileUtil::isExecutableFile(const char* filename) {
+    struct stat buf;
+    if (!filename || stat(filename, &buf) || !S_ISREG(buf.st_mode))
+        return false;
+
+    return buf.st_mode & S_IXUSR
+#ifdef S_IXGRP
+        || buf.st_mode & S_IXGRP
+#endif
+#ifdef S_IXOTH
+        || buf.st_mode & S_IXOTH
+#endif
+    ;
+}
+
 bool FileUtil::copyFile(const char* from, const char* to) {
     ifstream from_file(from);
     ofstream to_file(to);
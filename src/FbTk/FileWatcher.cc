@@ -0,0 +1,269 @@
+// FileWatcher.cc
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "FileWatcher.hh"
+
+#include "FileUtil.hh"
+#include "FbTime.hh"
+#include "SimpleCommand.hh"
+
+#ifdef HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // HAVE_SYS_INOTIFY_H
+
+#include <algorithm>
+#include <cstdlib>
+
+using std::string;
+
+namespace FbTk {
+
+namespace {
+
+/// a change leaving the path missing is reported once there was no
+/// other change for this long; it might be in the middle of being replaced
+const uint64_t QUIET_TIME = 100 * FbTime::IN_MILLISECONDS;
+/// how often the files are checked without inotify
+const uint64_t POLL_INTERVAL = 2 * FbTime::IN_SECONDS;
+
+string dirName(const string &path) {
+    string::size_type slash = path.rfind('/');
+    if (slash == string::npos)
+        return ".";
+    if (slash == 0)
+        return "/";
+    return path.substr(0, slash);
+}
+
+/// @return the path without symbolic links, "" if that's 'path' or unknown
+string realPath(const string &path) {
+    char *real = realpath(path.c_str(), 0);
+    if (real == 0)
+        return "";
+    string target(real);
+    free(real);
+    return target != path ? target : "";
+}
+
+} // end anonymous namespace
+
+FileWatcher &FileWatcher::instance() {
+    static FileWatcher watcher;
+    return watcher;
+}
+
+FileWatcher::FileWatcher():
+    m_fd(-1) {
+
+#ifdef HAVE_SYS_INOTIFY_H
+    m_fd = inotify_init();
+    if (m_fd != -1) {
+        fcntl(m_fd, F_SETFL, fcntl(m_fd, F_GETFL) | O_NONBLOCK);
+        fcntl(m_fd, F_SETFD, FD_CLOEXEC);
+    }
+#endif // HAVE_SYS_INOTIFY_H
+
+    RefCount<Command<void> > poll_cmd(new SimpleCommand<FileWatcher>(*this, &FileWatcher::poll));
+    m_poll_timer.setCommand(poll_cmd);
+    m_poll_timer.setTimeout(POLL_INTERVAL);
+    m_poll_timer.fireOnce(true);
+}
+
+FileWatcher::~FileWatcher() {
+#ifdef HAVE_SYS_INOTIFY_H
+    if (m_fd != -1)
+        close(m_fd);
+#endif // HAVE_SYS_INOTIFY_H
+}
+
+unsigned long FileWatcher::watch(const string &path) {
+
+    Files::iterator it = m_files.find(path);
+    if (it != m_files.end())
+        return serial(path);
+
+    File &file = m_files[path];
+    file.serial = 0;
+    file.pending = false;
+    file.changed = 0;
+    file.ctime = FileUtil::getLastStatusChangeTimestamp(path.c_str());
+    file.watched = addWatches(path, file);
+
+    if (!file.watched && !m_poll_timer.isTiming())
+        m_poll_timer.start();
+
+    return file.serial;
+}
+
+unsigned long FileWatcher::serial(const string &path) {
+
+    readEvents();
+
+    Files::iterator it = m_files.find(path);
+    if (it == m_files.end())
+        return 0;
+
+    File &file = it->second;
+    if (file.pending &&
+        (FbTime::mono() - file.changed >= QUIET_TIME ||
+         FileUtil::getLastStatusChangeTimestamp(path.c_str()) != -1)) {
+        ++file.serial;
+        file.pending = false;
+        // a symbolic link might point somewhere else now
+        if (file.watched)
+            file.watched = addWatches(path, file);
+    }
+    return file.serial;
+}
+
+bool FileWatcher::addWatches(const string &path, File &file) {
+
+    // the directory sees the file being replaced, the directory itself
+    // the changes of its entries. editing the file a symbolic link points
+    // to is only seen in the directory of that file.
+    file.target = realPath(path);
+    const string &real = file.target.empty() ? path : file.target;
+
+    if (addWatch(dirName(path)) == -1)
+        return false;
+    if (!file.target.empty() && addWatch(dirName(file.target)) == -1)
+        return false;
+    if (FileUtil::isDirectory(real.c_str()) && addWatch(real) == -1)
+        return false;
+    return true;
+}
+
+int FileWatcher::addWatch(const string &dir) {
+#ifdef HAVE_SYS_INOTIFY_H
+    if (m_fd == -1)
+        return -1;
+
+    int wd = inotify_add_watch(m_fd, dir.c_str(),
+            IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+            IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF);
+    if (wd != -1) {
+        std::vector<string> &names = m_dirs[wd];
+        if (std::find(names.begin(), names.end(), dir) == names.end())
+            names.push_back(dir);
+    }
+    return wd;
+#else
+    return -1;
+#endif // HAVE_SYS_INOTIFY_H
+}
+
+void FileWatcher::readEvents() {
+#ifdef HAVE_SYS_INOTIFY_H
+    if (m_fd == -1)
+        return;
+
+    const uint64_t now = FbTime::mono();
+    char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    ssize_t len;
+    while ((len = read(m_fd, buf, sizeof(buf))) > 0) {
+        for (char *p = buf; p < buf + len; ) {
+            const struct inotify_event *event =
+                reinterpret_cast<const struct inotify_event *>(p);
+            p += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                // events got lost, so anything might have changed
+                for (Files::iterator it = m_files.begin(); it != m_files.end(); ++it)
+                    changed(it->first, now);
+                continue;
+            }
+
+            Dirs::iterator dir = m_dirs.find(event->wd);
+            if (dir == m_dirs.end())
+                continue;
+
+            for (size_t i = 0; i < dir->second.size(); ++i) {
+                const string &dirname = dir->second[i];
+                if (event->len > 0 && event->name[0] != '\0') {
+                    changed(dirname + (dirname == "/" ? "" : "/") + event->name, now);
+                    // the entries of the directory changed
+                    if (event->mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO))
+                        changed(dirname, now);
+                } else {
+                    changed(dirname, now);
+                }
+            }
+
+            if (event->mask & IN_IGNORED) {
+                // the directory is gone, watching its files is up to poll()
+                const std::vector<string> &names = dir->second;
+                for (Files::iterator it = m_files.begin(); it != m_files.end(); ++it) {
+                    const string &real = it->second.target.empty() ?
+                        it->first : it->second.target;
+                    for (size_t i = 0; i < names.size(); ++i) {
+                        if (it->first == names[i] || dirName(it->first) == names[i] ||
+                            real == names[i] || dirName(real) == names[i])
+                            it->second.watched = false;
+                    }
+                }
+                m_dirs.erase(dir);
+                if (!m_poll_timer.isTiming())
+                    m_poll_timer.start();
+            }
+        }
+    }
+#endif // HAVE_SYS_INOTIFY_H
+}
+
+void FileWatcher::changed(const string &path, uint64_t now) {
+    // few files are watched, so looking at all of them is fine
+    for (Files::iterator it = m_files.begin(); it != m_files.end(); ++it) {
+        if (it->first == path || it->second.target == path) {
+            it->second.pending = true;
+            it->second.changed = now;
+        }
+    }
+}
+
+void FileWatcher::poll() {
+
+    const uint64_t now = FbTime::mono();
+    bool polling = false;
+
+    for (Files::iterator it = m_files.begin(); it != m_files.end(); ++it) {
+        File &file = it->second;
+        if (file.watched)
+            continue;
+
+        polling = true;
+        time_t ctime = FileUtil::getLastStatusChangeTimestamp(it->first.c_str());
+        if (ctime != file.ctime) {
+            file.ctime = ctime;
+            changed(it->first, now);
+        }
+
+        // maybe the directory is back
+        if (m_fd != -1)
+            file.watched = addWatches(it->first, file);
+    }
+
+    if (polling)
+        m_poll_timer.start();
+}
+
+} // end namespace FbTk
@@ -0,0 +1,92 @@
+// FileWatcher.hh
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef FBTK_FILEWATCHER_HH
+#define FBTK_FILEWATCHER_HH
+
+#include "NotCopyable.hh"
+#include "Timer.hh"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+namespace FbTk {
+
+/**
+   Tells if files or directories changed, without stat()ing them each time
+   it is asked.
+
+   Every watched path has a serial which changes whenever the path does.
+   Changes are reported by inotify, watching the directory of the path
+   so files replaced by editors are noticed too; for symbolic links the
+   directory of the file linked to is watched as well. Changes are collected
+   until the serial is asked for; if the path is missing then, it is
+   likely in the middle of being replaced by an editor, so the change is
+   held back until things calmed down. Where inotify is not available,
+   the status change time of the paths is polled by a timer.
+*/
+class FileWatcher: private NotCopyable {
+public:
+    static FileWatcher &instance();
+
+    /**
+       starts watching 'path', if not done yet
+       @return the current serial of 'path'
+    */
+    unsigned long watch(const std::string &path);
+
+    /// @return the current serial of 'path', which must be watched
+    unsigned long serial(const std::string &path);
+
+private:
+    FileWatcher();
+    ~FileWatcher();
+
+    struct File {
+        unsigned long serial;
+        bool pending;      ///< changed, but the burst might not be over
+        uint64_t changed;  ///< time of the last change
+        time_t ctime;      ///< for polling
+        bool watched;      ///< inotify watches it
+        std::string target; ///< the real path, if it differs
+    };
+    typedef std::map<std::string, File> Files;
+    /// a directory might have several names, e.g. via symbolic links
+    typedef std::map<int, std::vector<std::string> > Dirs;
+
+    /// @return true if all needed to see changes of 'path' is watched
+    bool addWatches(const std::string &path, File &file);
+    int addWatch(const std::string &dir);
+    void readEvents();
+    void changed(const std::string &path, uint64_t now);
+    void poll();
+
+    Files m_files;
+    Dirs m_dirs; ///< watched directories by watch descriptor
+    int m_fd;                          ///< inotify instance, -1 if none
+    Timer m_poll_timer;
+};
+
+} // end namespace FbTk
+
+#endif // FBTK_FILEWATCHER_HH
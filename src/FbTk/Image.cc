@@ -20,8 +20,8 @@
 // DEALINGS IN THE SOFTWARE.
 
 #include "Image.hh"
+#include "PixmapWithMask.hh"
 #include "StringUtil.hh"
-#include "FileUtil.hh"
 
 #ifdef HAVE_XPM
 #include "ImageXPM.hh"
@@ -31,6 +31,9 @@
 #include "ImageImlib2.hh"
 #endif // HAVE_IMLIB2
 
+#include <sys/types.h>
+#include <sys/stat.h>
+
 #include <list>
 #include <set>
 
@@ -54,6 +57,81 @@ FbTk::ImageImlib2 imlib2_loader;
 FbTk::ImageXPM xpm_loader;
 #endif
 
+/// filename -> path, as found by locateFile()
+typedef std::map<std::string, std::string> PathMap;
+PathMap s_paths;
+
+/// approximate memory the cached images may take on the X server
+const size_t IMAGE_CACHE_SIZE = 8 * 1024 * 1024;
+
+struct CachedImage {
+    time_t mtime;
+    off_t size;
+    FbTk::PixmapWithMask *image;
+    size_t bytes;
+    unsigned long used; ///< to find the least recently used one
+};
+/// (path, screen) -> decoded image
+typedef std::map<std::pair<std::string, int>, CachedImage> ImageCache;
+ImageCache s_image_cache;
+size_t s_image_cache_bytes = 0;
+unsigned long s_image_cache_used = 0;
+
+size_t imageBytes(const FbTk::PixmapWithMask &image) {
+    const size_t pixels = image.width() * image.height();
+    return pixels * 4 + (image.mask().drawable() != 0 ? pixels / 8 : 0);
+}
+
+void uncache(ImageCache::iterator it) {
+    s_image_cache_bytes -= it->second.bytes;
+    delete it->second.image;
+    s_image_cache.erase(it);
+}
+
+/// @return a copy of 'image' the caller owns
+FbTk::PixmapWithMask *copyImage(const FbTk::PixmapWithMask &image) {
+    FbTk::PixmapWithMask *copy = new FbTk::PixmapWithMask;
+    copy->pixmap().copy(image.pixmap());
+    copy->mask().copy(image.mask());
+    return copy;
+}
+
+/// @return true if 'path' is a regular file, 'st' holds its status then
+bool regularFile(const string &path, struct stat &st) {
+    return stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+/**
+   finds 'filename' as given or in the search paths
+   @param st the status of the file found, to not ask for it again
+   @return its path, empty if not found
+*/
+string locate(const string &filename, struct stat &st) {
+
+    PathMap::iterator it = s_paths.find(filename);
+    if (it != s_paths.end()) {
+        if (regularFile(it->second, st))
+            return it->second;
+        s_paths.erase(it);
+    }
+
+    string path = FbTk::StringUtil::expandFilename(filename);
+    if (!regularFile(path, st)) {
+        string base = FbTk::StringUtil::basename(filename);
+        StringList::iterator dir = s_search_paths.begin();
+        StringList::iterator dir_end = s_search_paths.end();
+        for (; dir != dir_end; ++dir) {
+            path = FbTk::StringUtil::expandFilename(*dir) + "/" + base;
+            if (regularFile(path, st))
+                break;
+        }
+        if (dir == dir_end)
+            return "";
+    }
+
+    s_paths[filename] = path;
+    return path;
+}
 
 } // end of anonymous namespace
 
@@ -69,29 +147,63 @@ PixmapWithMask *Image::load(const string &filename, int screen_num) {
     string extension(StringUtil::toUpper(StringUtil::findExtension(filename)));
 
     // valid handle?
-    if (s_image_map.find(extension) == s_image_map.end())
+    ImageMap::iterator loader = s_image_map.find(extension);
+    if (loader == s_image_map.end())
         return NULL;
 
-    string path = locateFile(filename);
-    if (!path.empty())
-        return s_image_map[extension]->load(path, screen_num);
+    struct stat st;
+    string path = locate(filename, st);
+    if (path.empty())
+        return 0;
+
+    const ImageCache::key_type key(path, screen_num);
+    ImageCache::iterator it = s_image_cache.find(key);
+    if (it != s_image_cache.end()) {
+        if (it->second.mtime == st.st_mtime && it->second.size == st.st_size) {
+            it->second.used = ++s_image_cache_used;
+            return copyImage(*it->second.image);
+        }
+        uncache(it);
+    }
+
+    PixmapWithMask *image = loader->second->load(path, screen_num);
+    if (image == 0)
+        return 0;
+
+    CachedImage cached;
+    cached.bytes = imageBytes(*image);
+    if (cached.bytes > IMAGE_CACHE_SIZE)
+        return image;
+
+    // make room for the new one
+    while (!s_image_cache.empty() &&
+           s_image_cache_bytes + cached.bytes > IMAGE_CACHE_SIZE) {
+        ImageCache::iterator oldest = s_image_cache.begin();
+        for (it = s_image_cache.begin(); it != s_image_cache.end(); ++it) {
+            if (it->second.used < oldest->second.used)
+                oldest = it;
+        }
+        uncache(oldest);
+    }
 
-    return 0;
+    cached.mtime = st.st_mtime;
+    cached.size = st.st_size;
+    cached.image = image;
+    cached.used = ++s_image_cache_used;
+    s_image_cache[key] = cached;
+    s_image_cache_bytes += cached.bytes;
+
+    return copyImage(*image);
+}
+
+void Image::shutdown() {
+    while (!s_image_cache.empty())
+        uncache(s_image_cache.begin());
 }
 
 string Image::locateFile(const string &filename) {
-    string path = StringUtil::expandFilename(filename);
-    if (FileUtil::isRegularFile(path.c_str()))
-        return path;
-    string base = StringUtil::basename(filename);
-    StringList::iterator it = s_search_paths.begin();
-    StringList::iterator it_end = s_search_paths.end();
-    for (; it != it_end; ++it) {
-        path = StringUtil::expandFilename(*it) + "/" + base;
-        if (FileUtil::isRegularFile(path.c_str()))
-            return path;
-    }
-    return "";
+    struct stat st;
+    return locate(filename, st);
 }
 
 bool Image::registerType(const string &type, ImageBase &base) {
@@ -129,14 +241,17 @@ void Image::remove(ImageBase &base) {
 
 void Image::addSearchPath(const string &search_path) {
     s_search_paths.push_back(search_path);
+    s_paths.clear();
 }
 
 void Image::removeSearchPath(const string &search_path) {
     s_search_paths.remove(search_path);
+    s_paths.clear();
 }
 
 void Image::removeAllSearchPaths() {
     s_search_paths.clear();
+    s_paths.clear();
 }
 
 } // end namespace FbTk
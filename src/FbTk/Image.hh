@@ -32,10 +32,18 @@ class ImageBase;
 class PixmapWithMask;
 
 /// loads images
+/**
+ Decoded images are kept in a cache, so loading the same file again (e.g.
+ menu icons on each reload of the menu) only copies the pixmaps on the
+ X server. The cache notices changed files by their modification time
+ and size, and holds images of a few megabytes at most.
+*/
 namespace Image {
 
     /// @return an instance of PixmapWithMask on success, 0 on failure
     PixmapWithMask *load(const std::string &filename, int screen_num);
+    /// frees the cached images, must be done before the display is closed
+    void shutdown();
     /// for register file type and imagebase
     /// @return false on failure
     bool registerType(const std::string &type, ImageBase &base);
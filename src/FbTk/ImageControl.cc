@@ -29,6 +29,7 @@
 #include "App.hh"
 #include "SimpleCommand.hh"
 #include "I18n.hh"
+#include "Stats.hh"
 
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>
@@ -61,6 +62,9 @@ bool s_timed_cache = true;
 bool s_timed_cache = false;
 #endif // TIMEDCACHE
 
+/// size of the strips rendered by ImageControl::renderBackground()
+const unsigned int BACKGROUND_STRIP = 16;
+
 
 void initColortables(unsigned char red[256], unsigned char green[256], unsigned char blue[256],
       int red_bits, int green_bits, int blue_bits) {
@@ -271,6 +275,8 @@ Pixmap ImageControl::renderImage(unsigned int width, unsigned int height,
                                  FbTk::Orientation orient,
                                  bool use_cache ) {
 
+    FBTK_STATS_TIME("ImageControl::renderImage");
+
     if (texture.type() & FbTk::Texture::PARENTRELATIVE)
         return ParentRelative;
 
@@ -283,8 +289,10 @@ Pixmap ImageControl::renderImage(unsigned int width, unsigned int height,
     // search cache first
     Pixmap pixmap = searchCache(width, height, texture, orient);
     if (pixmap) {
+        FBTK_STATS_COUNT("ImageControl cache hit");
         return pixmap; // return cache item
     }
+    FBTK_STATS_COUNT("ImageControl cache miss");
 
     // render new image
 
@@ -321,6 +329,39 @@ Pixmap ImageControl::renderImage(unsigned int width, unsigned int height,
     return None;
 }
 
+Pixmap ImageControl::renderBackground(unsigned int width, unsigned int height,
+                                      const FbTk::Texture &texture,
+                                      FbTk::Orientation orient) {
+
+    const unsigned long type = texture.type();
+    const bool rotated = (orient == ROT90 || orient == ROT270);
+
+    // does the texture stay the same along the x or y axis of the window?
+    bool same_x = false;
+    bool same_y = false;
+    if (texture.pixmap().drawable() == None &&
+        !(type & (Texture::BEVEL1 | Texture::BEVEL2))) {
+
+        if (type & Texture::SOLID) {
+            // solid textures are not rotated, interlacing draws rows
+            same_x = true;
+            same_y = !(type & Texture::INTERLACED);
+        } else if (type & Texture::VERTICAL) {
+            same_x = !rotated;
+            same_y = rotated;
+        } else if ((type & Texture::HORIZONTAL) && !(type & Texture::INTERLACED)) {
+            same_x = rotated;
+            same_y = !rotated;
+        }
+    }
+
+    if (same_x && width > BACKGROUND_STRIP)
+        width = BACKGROUND_STRIP;
+    else if (same_y && height > BACKGROUND_STRIP)
+        height = BACKGROUND_STRIP;
+
+    return renderImage(width, height, texture, orient);
+}
 
 void ImageControl::removeImage(Pixmap pixmap) {
     if (!pixmap)
@@ -66,6 +66,20 @@ public:
                        Orientation orient = ROT0,
                        bool use_cache = true);
 
+    /**
+       Render a window background. Textures which do not change along
+       one side (solid, vertical and horizontal gradients without bevel)
+       are rendered as a narrow strip only, which the X server tiles
+       across the window. The strip is shared by all windows of the same
+       height (or width), e.g. the buttons of the iconbar, no matter how
+       wide they are.
+       The pixmap must only be used as window background.
+       @see renderImage()
+    */
+    Pixmap renderBackground(unsigned int width, unsigned int height,
+                            const FbTk::Texture &src_texture,
+                            Orientation orient = ROT0);
+
     void installRootColormap();
     void removeImage(Pixmap thepix);
     void colorTables(const unsigned char **, const unsigned char **, const unsigned char **,
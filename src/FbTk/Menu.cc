@@ -35,6 +35,7 @@
 #include "Transparent.hh"
 #include "SimpleCommand.hh"
 #include "FbPixmap.hh"
+#include "Stats.hh"
 
 #include <X11/Xutil.h>
 #include <X11/Xatom.h>
@@ -391,6 +392,8 @@ void Menu::enableTitle() {
 
 void Menu::updateMenu() {
 
+    FBTK_STATS_TIME("Menu::updateMenu");
+
     int bevel = theme()->bevelWidth();
     int bw = theme()->borderWidth();
     int ih = theme()->itemHeight();
@@ -1138,10 +1141,16 @@ void Menu::keyPressEvent(XKeyEvent &event) {
         if (m_search->would_match(m_search->pattern + keychar[0])) {
             m_search->add(keychar[0]);
             drawTypeAheadItems();
-            // if current item doesn't match new search string, find
-            // the next one
+            // jump to the best match if the search ranks its matches,
+            // otherwise if current item doesn't match new search string,
+            // find the next one
             size_t ignore;
-            if (!m_search->get_match(m_active_index, ignore)) {
+            int best = m_search->best_match();
+            if (best >= 0 && isItemSelectable(best)) {
+                if (best != m_active_index) {
+                    setActiveIndex(best);
+                }
+            } else if (!m_search->get_match(m_active_index, ignore)) {
                 cycleItems(DOWN);
             }
         }
@@ -1282,8 +1291,9 @@ void Menu::clearItem(int index, bool clear, int search_index) {
     size_t start_idx = std::string::npos;
     size_t end_idx = std::string::npos;
 
-    if (m_search->get_match(index, start_idx)) {
-        end_idx = start_idx + m_search->size();
+    size_t match_len = 0;
+    if (m_search->get_match(index, start_idx, match_len)) {
+        end_idx = start_idx + match_len;
 
 #if 0
         std::cerr << "m_search " << index << "|"
@@ -342,8 +342,22 @@ void MenuItem::setIcon(const std::string &filename, int screen_num) {
         m_icon.reset(new Icon);
 
     m_icon->filename = FbTk::StringUtil::expandFilename(filename);
-    m_icon->pixmap.reset(Image::load(m_icon->filename.c_str(),
-                         screen_num));
+    m_icon->screen_num = screen_num;
+    m_icon->loaded = false;
+    m_icon->pixmap.reset(0);
+}
+
+const PixmapWithMask *MenuItem::icon() const {
+    if (m_icon.get() == 0)
+        return 0;
+
+    // loaded when the item is drawn first: the icons of submenus nobody
+    // opens are never loaded, and reading a menu doesn't wait for them
+    if (!m_icon->loaded) {
+        m_icon->loaded = true;
+        m_icon->pixmap.reset(Image::load(m_icon->filename, m_icon->screen_num));
+    }
+    return m_icon->pixmap.get();
 }
 
 unsigned int MenuItem::height(const FbTk::ThemeProxy<MenuTheme> &theme) const {
@@ -366,9 +380,9 @@ void MenuItem::updateTheme(const FbTk::ThemeProxy<MenuTheme> &theme) {
     if (m_icon.get() == 0)
         return;
 
-    m_icon->pixmap.reset(Image::load(m_icon->filename.c_str(), theme->screenNum()));
-
-
+    m_icon->screen_num = theme->screenNum();
+    m_icon->loaded = false;
+    m_icon->pixmap.reset(0);
 }
 
 void MenuItem::showSubmenu() {
@@ -105,9 +105,8 @@ public:
     */
     //@{
     virtual const FbTk::BiDiString& label() const { return m_label; }
-    virtual const PixmapWithMask *icon() const {
-        return m_icon.get() ? m_icon->pixmap.get() : 0;
-    }
+    /// the icon is loaded when it is asked for the first time
+    virtual const PixmapWithMask *icon() const;
     virtual const Menu *submenu() const { return m_submenu; }
     virtual bool isEnabled() const { return m_enabled; }
     virtual bool isSelected() const { return m_selected; }
@@ -157,6 +156,8 @@ private:
     struct Icon {
         std::auto_ptr<PixmapWithMask> pixmap;
         std::string filename;
+        int screen_num;
+        bool loaded;
     };
     std::auto_ptr<Icon> m_icon;
 };
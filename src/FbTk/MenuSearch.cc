@@ -3,31 +3,55 @@
 #include "StringUtil.hh"
 #include "Resource.hh"
 
+#include <algorithm>
+#include <cctype>
+
 namespace {
 
-size_t search_str_nowhere(const std::string& text, const std::string& pattern) {
-    return std::string::npos;
+FbTk::MenuSearch::Mode search_mode = FbTk::MenuSearch::DEFAULT;
+unsigned int search_mode_serial = 0;
+
+inline char lower_char(char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+inline uint64_t char_bit(char c) {
+    return static_cast<uint64_t>(1) << (static_cast<unsigned char>(c) & 63);
+}
+
+uint64_t char_mask(const std::string& s) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < s.size(); i++) {
+        mask |= char_bit(s[i]);
+    }
+    return mask;
 }
 
-// finds 'pattern' at beginning of 'text'
+const size_t TRIGRAM_BUCKETS = 4096;
+
+// bucket of the trigram starting at 's[i]'
+inline size_t trigram_bucket(const std::string& s, size_t i) {
+    uint32_t t = (static_cast<uint32_t>(static_cast<unsigned char>(s[i])) << 16) |
+        (static_cast<uint32_t>(static_cast<unsigned char>(s[i+1])) << 8) |
+        static_cast<uint32_t>(static_cast<unsigned char>(s[i+2]));
+    return (t * 2654435761u) >> 20;
+}
+
+// finds 'pattern' at beginning of 'text'. 'text' is lowercased already
 size_t search_str_textstart(const std::string& text, const std::string& pattern) {
 
-    size_t l = std::min(text.size(), pattern.size());
-    if (l == 0) {
+    if (pattern.empty() || pattern.size() > text.size()) {
         return std::string::npos;
     }
 
-    size_t i;
-    for (i = l; i > 0; i--) {
-        if (std::tolower(text[i-1]) != pattern[i-1]) {
-            return std::string::npos;
-        }
+    if (text.compare(0, pattern.size(), pattern) != 0) {
+        return std::string::npos;
     }
 
-    return i;
+    return 0;
 }
 
-// finds 'pattern' in 'text', case insensitive.
+// finds 'pattern' in 'text'. 'text' is lowercased already.
 // returns position or std::string::npos if not found.
 //
 // implements Boyer–Moore–Horspool
@@ -46,13 +70,7 @@ size_t search_str_bmh(const std::string& text, const std::string& pattern) {
 
     // simple case, no need to be too clever
     if (plen == 1) {
-        int b = pattern[0];
-        for (t = 0; t < tlen; t++) {
-            if (b == std::tolower(text[t])) {
-                return t;
-            }
-        }
-        return std::string::npos;
+        return text.find(pattern[0]);
     }
 
     // prepare skip-table
@@ -65,26 +83,102 @@ size_t search_str_bmh(const std::string& text, const std::string& pattern) {
         skip[p] = plen;
     }
     for (p = 0; p < pe; p++) {
-        skip[pattern[p]] = pe - p;
+        skip[static_cast<unsigned char>(pattern[p])] = pe - p;
     }
 
     // match
     //
     for (t = 0; (t+pe) < tlen; ) {
-        for (p = pe; std::tolower(text[t+p]) == pattern[p]; p--) {
+        for (p = pe; text[t+p] == pattern[p]; p--) {
             if (p == 0) {
                 return t;
             }
         }
-        t += skip[std::tolower(text[t+pe])];
+        t += skip[static_cast<unsigned char>(text[t+pe])];
     }
 
     return std::string::npos;
 }
 
 
-// actually search function, depends on Mode
-size_t (*search_str)(const std::string&, const std::string&) = search_str_textstart;
+// fzf-like scoring of 'pattern' as a subsequence of 'text'
+enum {
+    SCORE_MATCH = 16,
+    BONUS_BOUNDARY = 8,
+    BONUS_CONSECUTIVE = 4,
+    PENALTY_GAP_START = 3,
+    PENALTY_GAP_EXTENSION = 1
+};
+
+// is 'label[i]' the start of a word?
+bool is_boundary(const std::string& label, size_t i) {
+    if (i == 0) {
+        return true;
+    }
+    unsigned char prev = label[i-1];
+    unsigned char cur = label[i];
+    if (!std::isalnum(prev)) {
+        return true;
+    }
+    return std::islower(prev) && std::isupper(cur);
+}
+
+// returns the score of the match or -1 if 'pattern' is not a subsequence
+// of 'lower'. 'start' and 'end' mark the shortest span which contains the
+// leftmost match.
+int search_str_fuzzy(const std::string& label, const std::string& lower,
+        const std::string& pattern, size_t& start, size_t& end) {
+
+    const size_t tlen = lower.size();
+    const size_t plen = pattern.size();
+    size_t t;
+    size_t p;
+
+    if (plen == 0 || plen > tlen) {
+        return -1;
+    }
+
+    // forward: find the leftmost end of the subsequence
+    for (t = 0, p = 0; t < tlen && p < plen; t++) {
+        if (lower[t] == pattern[p]) {
+            p++;
+        }
+    }
+    if (p < plen) {
+        return -1;
+    }
+    end = t;
+
+    // backward: tighten the start of the span
+    for (p = plen; p > 0; ) {
+        t--;
+        if (lower[t] == pattern[p-1]) {
+            p--;
+        }
+    }
+    start = t;
+
+    int score = 0;
+    bool prev_matched = false;
+    for (t = start, p = 0; t < end && p < plen; t++) {
+        if (lower[t] == pattern[p]) {
+            score += SCORE_MATCH;
+            if (prev_matched) {
+                score += BONUS_CONSECUTIVE;
+            }
+            if (is_boundary(label, t)) {
+                score += BONUS_BOUNDARY;
+            }
+            prev_matched = true;
+            p++;
+        } else {
+            score -= prev_matched ? PENALTY_GAP_START : PENALTY_GAP_EXTENSION;
+            prev_matched = false;
+        }
+    }
+
+    return std::max(score, 0);
+}
 
 } // anonymous
 
@@ -94,31 +188,30 @@ namespace FbTk {
 
 
 void MenuSearch::setMode(MenuSearch::Mode m) {
-    if (m == NOWHERE) {
-        search_str = search_str_nowhere;
-    } else if (m == SOMEWHERE) {
-        search_str = search_str_bmh;
-    } else {
-        search_str = search_str_textstart;
+    if (m != search_mode) {
+        search_mode = m;
+        search_mode_serial++;
     }
 }
 
 
 
-MenuSearch::MenuSearch(const std::vector<FbTk::MenuItem*>& items) : 
-    m_items(items) {
+MenuSearch::MenuSearch(const std::vector<FbTk::MenuItem*>& items) :
+    m_items(items),
+    m_trigrams_dirty(true),
+    m_mode_serial(search_mode_serial) {
 }
 
-size_t MenuSearch::size() const { 
+size_t MenuSearch::size() const {
     return pattern.size();
 }
 
-void MenuSearch::clear() { 
+void MenuSearch::clear() {
     pattern.clear();
 }
 
 void MenuSearch::add(char c) {
-    pattern.push_back(std::tolower(c));
+    pattern.push_back(lower_char(c));
 }
 
 void MenuSearch::backspace() {
@@ -130,26 +223,15 @@ void MenuSearch::backspace() {
 
 // is 'pattern' matching something?
 bool MenuSearch::has_match() {
-    size_t l = m_items.size();
-    size_t i;
-    for (i = 0; i < l; i++) {
-        if (!m_items[i]->isEnabled())
-            continue;
-        if (search_str(m_items[i]->iTypeString(), pattern) != std::string::npos) {
-            return true;
-        }
-    }
-    return false;
+    return would_match(pattern);
 }
 
 // would 'the_pattern' match something?
 bool MenuSearch::would_match(const std::string& the_pattern) {
-    size_t l = m_items.size();
+    const std::vector<size_t>& m = matches(the_pattern);
     size_t i;
-    for (i = 0; i < l; i++) {
-        if (!m_items[i]->isEnabled())
-            continue;
-        if (search_str(m_items[i]->iTypeString(), the_pattern) != std::string::npos) {
+    for (i = 0; i < m.size(); i++) {
+        if (m_items[m[i]]->isEnabled()) {
             return true;
         }
     }
@@ -157,12 +239,10 @@ bool MenuSearch::would_match(const std::string& the_pattern) {
 }
 
 size_t MenuSearch::num_matches() {
-    size_t l = m_items.size();
+    const std::vector<size_t>& m = matches(pattern);
     size_t i, n;
-    for (i = 0, n = 0; i < l; i++) {
-        if (!m_items[i]->isEnabled())
-            continue;
-        if (search_str(m_items[i]->iTypeString(), pattern) != std::string::npos) {
+    for (i = 0, n = 0; i < m.size(); i++) {
+        if (m_items[m[i]]->isEnabled()) {
             n++;
         }
     }
@@ -174,15 +254,238 @@ size_t MenuSearch::num_matches() {
 // the position where it matches in the string. an empty
 // 'pattern' always matches
 bool MenuSearch::get_match(size_t i, size_t& idx) {
-    if (i > m_items.size()) {
+    size_t ignore;
+    return get_match(i, idx, ignore);
+}
+
+bool MenuSearch::get_match(size_t i, size_t& idx, size_t& len) {
+    if (i >= m_items.size()) {
         return false;
     }
 
     if (pattern.empty())
         return true;
 
-    idx = search_str(m_items[i]->iTypeString(), pattern);
-    return idx != std::string::npos;
+    entry(i);
+    return match(i, pattern, idx, len) >= 0;
+}
+
+int MenuSearch::best_match() {
+    if (search_mode != FUZZY || pattern.empty()) {
+        return -1;
+    }
+
+    const std::vector<size_t>& m = matches(pattern);
+    int best = -1;
+    int best_score = -1;
+    size_t i, idx, len;
+    for (i = 0; i < m.size(); i++) {
+        if (!m_items[m[i]]->isEnabled())
+            continue;
+        int score = match(m[i], pattern, idx, len);
+        if (score > best_score) {
+            best_score = score;
+            best = m[i];
+        }
+    }
+    return best;
+}
+
+
+// brings m_index up to date with m_items. only items which were added or
+// got a new label are (re)indexed. the cached matches are dropped if
+// anything changed.
+void MenuSearch::sync() {
+
+    if (m_mode_serial != search_mode_serial) {
+        m_mode_serial = search_mode_serial;
+        m_levels.clear();
+    }
+
+    for (size_t i = 0; i < m_items.size(); i++) {
+        entry(i);
+    }
+
+    if (m_index.size() > m_items.size()) {
+        m_index.resize(m_items.size());
+        m_levels.clear();
+        m_trigrams_dirty = true;
+    }
+}
+
+const MenuSearch::Entry& MenuSearch::entry(size_t i) {
+
+    if (m_index.size() < m_items.size()) {
+        m_index.resize(m_items.size());
+    }
+
+    Entry& e = m_index[i];
+    const std::string& label = m_items[i]->iTypeString();
+    if (e.item == m_items[i] && e.label == label) {
+        return e;
+    }
+
+    e.item = m_items[i];
+    e.label = label;
+    e.lower.resize(label.size());
+    for (size_t j = 0; j < label.size(); j++) {
+        e.lower[j] = lower_char(label[j]);
+    }
+    e.chars = char_mask(e.lower);
+
+    m_levels.clear();
+    m_trigrams_dirty = true;
+    return e;
+}
+
+// a counting sort of the trigrams of all items into their buckets,
+// linear in the total length of the labels
+void MenuSearch::buildTrigrams() {
+
+    std::vector<size_t> last(TRIGRAM_BUCKETS, std::string::npos);
+    size_t i, j, b;
+
+    m_trigram_heads.assign(TRIGRAM_BUCKETS + 1, 0);
+    for (i = 0; i < m_index.size(); i++) {
+        const std::string& s = m_index[i].lower;
+        for (j = 0; j + 2 < s.size(); j++) {
+            b = trigram_bucket(s, j);
+            if (last[b] != i) {
+                last[b] = i;
+                m_trigram_heads[b + 1]++;
+            }
+        }
+    }
+    for (b = 0; b < TRIGRAM_BUCKETS; b++) {
+        m_trigram_heads[b + 1] += m_trigram_heads[b];
+    }
+
+    std::vector<size_t> fill(m_trigram_heads.begin(), m_trigram_heads.end() - 1);
+    last.assign(TRIGRAM_BUCKETS, std::string::npos);
+    m_trigram_items.resize(m_trigram_heads[TRIGRAM_BUCKETS]);
+    for (i = 0; i < m_index.size(); i++) {
+        const std::string& s = m_index[i].lower;
+        for (j = 0; j + 2 < s.size(); j++) {
+            b = trigram_bucket(s, j);
+            if (last[b] != i) {
+                last[b] = i;
+                m_trigram_items[fill[b]++] = i;
+            }
+        }
+    }
+
+    m_trigrams_dirty = false;
+}
+
+// returns the indices of the items matching 'the_pattern', enabled or not.
+//
+// the result is narrowed down from the matches of the longest already
+// known prefix of 'the_pattern'
+const std::vector<size_t>& MenuSearch::matches(const std::string& the_pattern) {
+
+    sync();
+
+    if (m_levels.empty()) {
+        Level all;
+        all.items.resize(m_index.size());
+        for (size_t i = 0; i < all.items.size(); i++) {
+            all.items[i] = i;
+        }
+        m_levels.push_back(all);
+    }
+
+    // find the longest cached prefix of 'the_pattern'
+    size_t k;
+    for (k = 1; k < m_levels.size(); k++) {
+        const std::string& p = m_levels[k].pattern;
+        if (p.size() > the_pattern.size() || the_pattern.compare(0, p.size(), p) != 0) {
+            break;
+        }
+    }
+    k--;
+
+    if (m_levels[k].pattern.size() == the_pattern.size()) {
+        return m_levels[k].items;
+    }
+
+    m_levels.resize(k + 1);
+
+    std::vector<size_t> candidates;
+    const std::vector<size_t>* from = &m_levels[k].items;
+
+    // without any prefix to narrow down from, the trigrams of
+    // 'the_pattern' give the items which might contain it
+    if (k == 0 && search_mode == SOMEWHERE && the_pattern.size() >= 3) {
+
+        if (m_trigrams_dirty) {
+            buildTrigrams();
+        }
+
+        // the rarest trigram yields the smallest candidate list. a
+        // bucket might contain items of other trigrams as well, match()
+        // sorts them out.
+        size_t i, b, rarest = trigram_bucket(the_pattern, 0);
+        for (i = 1; i + 2 < the_pattern.size(); i++) {
+            b = trigram_bucket(the_pattern, i);
+            if (m_trigram_heads[b + 1] - m_trigram_heads[b] <
+                    m_trigram_heads[rarest + 1] - m_trigram_heads[rarest]) {
+                rarest = b;
+            }
+        }
+        candidates.assign(m_trigram_items.begin() + m_trigram_heads[rarest],
+                m_trigram_items.begin() + m_trigram_heads[rarest + 1]);
+        from = &candidates;
+    }
+
+    Level level;
+    level.pattern = the_pattern;
+
+    size_t i, idx, len;
+    for (i = 0; i < from->size(); i++) {
+        if (match((*from)[i], the_pattern, idx, len) >= 0) {
+            level.items.push_back((*from)[i]);
+        }
+    }
+
+    m_levels.push_back(level);
+    return m_levels.back().items;
+}
+
+// matches 'the_pattern' against the indexed item 'i'. returns -1 if
+// there is no match, otherwise the score of the match.
+int MenuSearch::match(size_t i, const std::string& the_pattern, size_t& idx, size_t& len) const {
+
+    const Entry& e = m_index[i];
+    uint64_t mask = char_mask(the_pattern);
+
+    if ((e.chars & mask) != mask) {
+        return -1;
+    }
+
+    switch (search_mode) {
+    case ITEMSTART:
+    case SOMEWHERE:
+        idx = (search_mode == ITEMSTART) ?
+            search_str_textstart(e.lower, the_pattern) :
+            search_str_bmh(e.lower, the_pattern);
+        if (idx == std::string::npos) {
+            return -1;
+        }
+        len = the_pattern.size();
+        return 0;
+    case FUZZY: {
+        size_t end;
+        int score = search_str_fuzzy(e.label, e.lower, the_pattern, idx, end);
+        if (score >= 0) {
+            len = end - idx;
+        }
+        return score;
+    }
+    default:
+        break;
+    }
+
+    return -1;
 }
 
 
@@ -199,6 +502,8 @@ std::string FbTk::Resource<FbTk::MenuSearch::Mode>::getString() const {
         return "nowhere";
     case FbTk::MenuSearch::SOMEWHERE:
         return "somewhere";
+    case FbTk::MenuSearch::FUZZY:
+        return "fuzzy";
     default:
         return "itemstart";
     };
@@ -212,6 +517,8 @@ void FbTk::Resource<FbTk::MenuSearch::Mode>::setFromString(const char *strval) {
         m_value = FbTk::MenuSearch::NOWHERE;
     } else if (val == "somewhere") {
         m_value = FbTk::MenuSearch::SOMEWHERE;
+    } else if (val == "fuzzy") {
+        m_value = FbTk::MenuSearch::FUZZY;
     } else {
         setDefaultValue();
     }
@@ -5,6 +5,10 @@
 #include <string>
 #include <cstddef>
 
+#ifdef HAVE_INTTYPES_H
+#include <inttypes.h>
+#endif // HAVE_INTTYPES_H
+
 namespace FbTk {
 
 class MenuItem;
@@ -17,6 +21,11 @@ class MenuItem;
 // flying around.
 //
 // MenuSearch is case insensitive.
+//
+// the labels of the items are lowercased once and kept in an index which
+// is synced against the items on each query. the matching items of each
+// typed prefix are remembered, so a growing pattern only has to look at
+// the items which matched the shorter pattern.
 class MenuSearch {
 public:
 
@@ -24,6 +33,7 @@ public:
         NOWHERE,
         ITEMSTART,
         SOMEWHERE,
+        FUZZY,
 
         DEFAULT = ITEMSTART
     };
@@ -50,9 +60,49 @@ public:
     // the position where it matches in the string
     bool get_match(size_t i, size_t& idx);
 
+    // same as above, but also stores the length of the matched part.
+    // in FUZZY mode this spans from the first to the last matched char
+    bool get_match(size_t i, size_t& idx, size_t& len);
+
+    // returns the index of the best scoring enabled item or -1.
+    // only FUZZY mode ranks its matches, all other modes return -1
+    int best_match();
+
     std::string pattern;
 private:
+
+    struct Entry {
+        Entry() : item(0), chars(0) { }
+
+        const MenuItem* item;
+        std::string label;   // as shown
+        std::string lower;   // lowercased 'label'
+        uint64_t chars;      // bitmask of the chars in 'lower'
+    };
+
+    // items matching 'pattern'
+    struct Level {
+        std::string pattern;
+        std::vector<size_t> items;
+    };
+
+    void sync();
+    const Entry& entry(size_t i);
+    void buildTrigrams();
+    const std::vector<size_t>& matches(const std::string& the_pattern);
+    int match(size_t i, const std::string& the_pattern, size_t& idx, size_t& len) const;
+
     const std::vector<FbTk::MenuItem*>& m_items;
+
+    std::vector<Entry> m_index;
+    std::vector<Level> m_levels; // m_levels[n].pattern is prefix of m_levels[n+1].pattern
+    // items containing a trigram, bucketed by the hash of the trigram.
+    // the items of bucket b are m_trigram_items[m_trigram_heads[b] ..
+    // m_trigram_heads[b+1]). built on demand.
+    std::vector<size_t> m_trigram_heads;
+    std::vector<size_t> m_trigram_items;
+    bool m_trigrams_dirty;
+    unsigned int m_mode_serial; // to notice mode changes
 };
 
 }
@@ -24,6 +24,29 @@
 
 namespace FbTk {
 
+/**
+ * Base for objects which carry their own reference count. RefCount then
+ * needs no extra allocation for the counter. It must be a base of the
+ * type the RefCount is declared with, not only of a derived type.
+ */
+class RefCounted {
+protected:
+    RefCounted(): m_refcount(0) { }
+    // a copy is a new object, without references
+    RefCounted(const RefCounted &): m_refcount(0) { }
+    RefCounted &operator = (const RefCounted &) { return *this; }
+    ~RefCounted() { }
+
+private:
+    mutable unsigned int m_refcount;
+
+    friend unsigned int *refCountOf(const RefCounted *p);
+};
+
+/// @return the counter inside 'p', or 0 if it has none
+inline unsigned int *refCountOf(const RefCounted *p) { return &p->m_refcount; }
+inline unsigned int *refCountOf(const void *) { return 0; }
+
 /// holds a pointer with reference counting, similar to std:auto_ptr
 template <typename Pointer>
 class RefCount {
@@ -45,12 +68,16 @@ public:
     operator bool_type() const { return m_data ? &RefCount::m_data : 0; }
 
 private:
+    /// starts counting m_data
+    void initRefCount();
     /// increase reference count
     void incRefCount();
     /// decrease reference count
     void decRefCount();
     Pointer *m_data; ///< data holder
-    unsigned int *m_refcount; ///< holds reference counting
+    /// holds reference counting; inside m_data if it is RefCounted,
+    /// 0 if m_data is 0
+    unsigned int *m_refcount;
 
     // we need this for the template copy constructor
     template<typename Pointer2>
@@ -60,8 +87,7 @@ private:
 // implementation
 
 template <typename Pointer>
-RefCount<Pointer>::RefCount():m_data(0), m_refcount(new unsigned int(0)) {
-    incRefCount(); // it really counts how many things are storing m_refcount
+RefCount<Pointer>::RefCount():m_data(0), m_refcount(0) {
 }
 
 template <typename Pointer>
@@ -73,8 +99,8 @@ RefCount<Pointer>::RefCount(const RefCount<Pointer2> &copy):
 }
 
 template <typename Pointer>
-RefCount<Pointer>::RefCount(Pointer *p):m_data(p), m_refcount(new unsigned int(0)) {
-    incRefCount();
+RefCount<Pointer>::RefCount(Pointer *p):m_data(p), m_refcount(0) {
+    initRefCount();
 }
 
 template <typename Pointer>
@@ -91,10 +117,14 @@ RefCount<Pointer>::~RefCount() {
 
 template <typename Pointer>
 RefCount<Pointer> &RefCount<Pointer>::operator = (const RefCount<Pointer> &copy) {
+    // inc first, copy might be held only by us
+    unsigned int *refcount = copy.m_refcount;
+    Pointer *data = copy.m_data;
+    if (refcount)
+        (*refcount)++;
     decRefCount(); // dec current ref count
-    m_refcount = copy.m_refcount; // set new ref count
-    m_data = copy.m_data; // set new data pointer
-    incRefCount(); // inc new ref count 
+    m_refcount = refcount; // set new ref count
+    m_data = data; // set new data pointer
     return *this;
 }
 
@@ -102,27 +132,35 @@ template <typename Pointer>
 void RefCount<Pointer>::reset(Pointer *p) {
     decRefCount();
     m_data = p; // set data pointer
-    m_refcount = new unsigned int(0); // create new counter
+    initRefCount();
+}
+
+template <typename Pointer>
+void RefCount<Pointer>::initRefCount() {
+    // a complete type is needed to know whether it is RefCounted
+    (void)sizeof(Pointer);
+    if (m_data == 0)
+        return;
+    m_refcount = refCountOf(m_data);
+    if (m_refcount == 0)
+        m_refcount = new unsigned int(0); // create new counter
     incRefCount();
 }
 
 template <typename Pointer>
 void RefCount<Pointer>::decRefCount() {
+    (void)sizeof(Pointer);
     if (m_refcount == 0)
         return;
-    if (*m_refcount == 0) { // already zero, then delete refcount
-        delete m_refcount;
-        m_refcount = 0;
-        return;
-    }
     (*m_refcount)--;
     if (*m_refcount == 0) { // destroy m_data and m_refcount if nobody else is using this
-        if (m_data != 0)
-            delete m_data;
-        m_data = 0;
-        delete m_refcount;
-        m_refcount = 0;
+        bool own_counter = m_refcount != refCountOf(m_data);
+        delete m_data;
+        if (own_counter)
+            delete m_refcount;
     }
+    m_data = 0;
+    m_refcount = 0;
 }
 
 template <typename Pointer>
@@ -23,20 +23,6 @@
 
 #include "FbWindow.hh"
 #include "App.hh"
-#include "GContext.hh"
-#include "FbPixmap.hh"
-
-#ifdef HAVE_CSTRING
-  #include <cstring>
-#else
-  #include <string.h>
-#endif
-
-#ifdef HAVE_CSTDLIB
-  #include <cstdlib>
-#else
-  #include <stdlib.h>
-#endif
 
 #include <X11/Xutil.h>
 
@@ -53,106 +39,49 @@ using std::min;
 namespace FbTk {
 
 namespace {
-/* rows is an array of 8 bytes, i.e. 8x8 bits */
-Pixmap makePixmap(Display* disp, int screen_nr, Window parent, const unsigned char rows[]) {
-
-    const size_t data_size = 8 * 8;
-    // we use malloc here so we get consistent C alloc/free with XDestroyImage
-    // and no warnings in valgrind :)
-    char *data = (char *)malloc(data_size * sizeof (char));
-    if (data == 0)
-        return 0;
-
-    memset(data, 0xFF, data_size);
-
-    XImage *ximage = XCreateImage(disp,
-                                  DefaultVisual(disp, screen_nr),
-                                  1,
-                                  XYPixmap, 0,
-                                  data,
-                                  8, 8,
-                                  32, 0);
-    if (ximage == 0) {
-        free(data);
-        return 0;
-    }
 
-    XInitImage(ximage);
-
-    for (int y=0; y<8; y++) {
-        for (int x=0; x<8; x++) {
-            XPutPixel(ximage, x, y, (rows[y] & (0x01 << x)) ? 0 : 1); // inverted, it is subtracted
+/* rows is an array of 8 bytes, i.e. 8x8 bits. a set bit is part of the
+ * window, the others are cut off */
+struct Corner {
+    explicit Corner(const unsigned char rows[]) {
+        // one rectangle per run of cut off pixels in a row
+        for (short y = 0; y < 8; y++) {
+            for (short x = 0; x < 8; x++) {
+                if (rows[y] & (0x01 << x))
+                    continue;
+                XRectangle rect;
+                rect.x = x;
+                rect.y = y;
+                rect.height = 1;
+                for (rect.width = 0; x < 8 && !(rows[y] & (0x01 << x)); x++)
+                    rect.width++;
+                rects.push_back(rect);
+            }
         }
     }
 
-    FbPixmap pm(parent, 8, 8, 1);
-    GContext gc(pm);
-
-    XPutImage(disp, pm.drawable(), gc.gc(), ximage, 0, 0, 0, 0,
-              8, 8);
-
-    XDestroyImage(ximage);
-
-    return pm.release();
-}
-
-struct CornerPixmaps {
-    CornerPixmaps() : do_create(true) { }
-
-    FbPixmap topleft;
-    FbPixmap topright;
-    FbPixmap botleft;
-    FbPixmap botright;
-
-    bool do_create;
-};
-
-// unfortunately, we need a separate pixmap per screen
-std::vector<CornerPixmaps> s_corners;
-
-unsigned long nr_shapes = 0;
-
-void initCorners(int screen) {
-
-    Display* disp = App::instance()->display();
-    if (s_corners.empty())
-        s_corners.resize(ScreenCount(disp));
-
-
-    if (screen < 0 || screen > static_cast<int>(s_corners.size())) {
-        std::cerr << "FbTk/Shape.cc:initCorners(), invalid argument: " << screen << "\n";
-        return;
-    }
-
-    static const unsigned char left_bits[] = { 0xc0, 0xf8, 0xfc, 0xfe, 0xfe, 0xfe, 0xff, 0xff };
-    static const unsigned char right_bits[] = { 0x03, 0x1f, 0x3f, 0x7f, 0x7f, 0x7f, 0xff, 0xff};
-    static const unsigned char bottom_left_bits[] = { 0xff, 0xff, 0xfe, 0xfe, 0xfe, 0xfc, 0xf8, 0xc0 };
-    static const unsigned char bottom_right_bits[] = { 0xff, 0xff, 0x7f, 0x7f, 0x7f, 0x3f, 0x1f, 0x03 };
-
-    CornerPixmaps& corners = s_corners[screen];
-    if (corners.do_create) {
-
-        Window root = RootWindow(disp, screen);
-        corners.topleft = makePixmap(disp, screen, root, left_bits);
-        corners.topright = makePixmap(disp, screen, root, right_bits);
-        corners.botleft = makePixmap(disp, screen, root, bottom_left_bits);
-        corners.botright = makePixmap(disp, screen, root, bottom_right_bits);
-        corners.do_create = false;
+    /// adds the part cut off to 'region', with the corner at x, y
+    void addTo(Region region, int x, int y) const {
+        for (size_t i = 0; i < rects.size(); ++i) {
+            XRectangle rect = rects[i];
+            rect.x += x;
+            rect.y += y;
+            XUnionRectWithRegion(&rect, region, region);
+        }
     }
 
-    nr_shapes++; // refcounting
-}
-
-void cleanCorners() {
+    std::vector<XRectangle> rects;
+};
 
-    if (nr_shapes == 1) {
-        s_corners.clear();
-    }
+const unsigned char left_bits[] = { 0xc0, 0xf8, 0xfc, 0xfe, 0xfe, 0xfe, 0xff, 0xff };
+const unsigned char right_bits[] = { 0x03, 0x1f, 0x3f, 0x7f, 0x7f, 0x7f, 0xff, 0xff};
+const unsigned char bottom_left_bits[] = { 0xff, 0xff, 0xfe, 0xfe, 0xfe, 0xfc, 0xf8, 0xc0 };
+const unsigned char bottom_right_bits[] = { 0xff, 0xff, 0x7f, 0x7f, 0x7f, 0x3f, 0x1f, 0x03 };
 
-    if (nr_shapes > 0) {
-        nr_shapes--; // refcounting
-    }
-}
+const Corner topleft(left_bits);
+const Corner topright(right_bits);
+const Corner botleft(bottom_left_bits);
+const Corner botright(bottom_right_bits);
 
 } // end of anonymous namespace
 
@@ -161,11 +90,8 @@ Shape::Shape(FbWindow &win, int shapeplaces):
     m_shapesource(0),
     m_shapesource_xoff(0),
     m_shapesource_yoff(0),
-    m_shapeplaces(shapeplaces) {
-
-#ifdef SHAPE
-    initCorners(win.screenNumber());
-#endif
+    m_shapeplaces(shapeplaces),
+    m_applied_valid(false) {
 
     update();
 }
@@ -188,8 +114,6 @@ Shape::~Shape() {
                           0,
                           ShapeSet);
     }
-
-    cleanCorners();
 #endif // SHAPE
 }
 
@@ -197,11 +121,43 @@ void Shape::setPlaces(int shapeplaces) {
     m_shapeplaces = shapeplaces;
 }
 
+bool Shape::State::operator == (const State &other) const {
+    return window == other.window &&
+        width == other.width && height == other.height &&
+        border_width == other.border_width && places == other.places &&
+        source == other.source &&
+        source_width == other.source_width &&
+        source_height == other.source_height &&
+        source_xoff == other.source_xoff && source_yoff == other.source_yoff;
+}
+
 void Shape::update() {
     if (m_win == 0 || m_win->window() == 0)
         return;
 
 #ifdef SHAPE
+    /**
+     * Nothing to do if the shape would be the same as the last one,
+     * e.g. when the window is only moved.
+     */
+    State state;
+    state.window = m_win->window();
+    state.width = m_win->width();
+    state.height = m_win->height();
+    state.border_width = m_win->borderWidth();
+    state.places = m_shapeplaces;
+    state.source = m_shapesource ? m_shapesource->window() : None;
+    state.source_width = m_shapesource ? m_shapesource->width() : 0;
+    state.source_height = m_shapesource ? m_shapesource->height() : 0;
+    state.source_xoff = m_shapesource_xoff;
+    state.source_yoff = m_shapesource_yoff;
+
+    if (m_applied_valid && m_applied == state)
+        return;
+
+    m_applied = state;
+    m_applied_valid = true;
+
     /**
      * Set the client's shape in position,
      * or wipe the shape and return.
@@ -224,6 +180,39 @@ void Shape::update() {
         return;
     }
 
+    /**
+     * The corners to cut off, all of them in one region per shape kind,
+     * so they take one request instead of one per corner.
+     * Note that the bottom corners y-vals are offset by 8 (the height
+     * of the corners).
+     */
+    Region clip_corners = XCreateRegion();
+    Region bound_corners = XCreateRegion();
+
+    // Set the top corners if the y offset is nonzero.
+    if (m_shapesource == 0 || m_shapesource_yoff != 0) {
+        if (m_shapeplaces & TOPLEFT) {
+            topleft.addTo(clip_corners, 0, 0);
+            topleft.addTo(bound_corners, -bw, -bw);
+        }
+        if (m_shapeplaces & TOPRIGHT) {
+            topright.addTo(clip_corners, width-8, 0);
+            topright.addTo(bound_corners, width+bw-8, -bw);
+        }
+    }
+
+    if (m_shapesource == 0 || (m_shapesource_yoff+(signed) m_shapesource->height()) < height
+        || m_shapesource_yoff >= height /* shaded */) {
+        if (m_shapeplaces & BOTTOMLEFT) {
+            botleft.addTo(clip_corners, 0, height-8);
+            botleft.addTo(bound_corners, -bw, height+bw-8);
+        }
+        if (m_shapeplaces & BOTTOMRIGHT) {
+            botright.addTo(clip_corners, width-8, height-8);
+            botright.addTo(bound_corners, width+bw-8, height+bw-8);
+        }
+    }
+
     Region clip = XCreateRegion();
     Region bound = XCreateRegion();
 
@@ -286,7 +275,22 @@ void Shape::update() {
                             m_win->window(), ShapeBounding,
                             0, 0, // offsets
                             bound, ShapeUnion);
+
+        // the corners might overlap the shape of the source
+        if (!XEmptyRegion(clip_corners))
+            XShapeCombineRegion(display,
+                                m_win->window(), ShapeClip,
+                                0, 0, // offsets
+                                clip_corners, ShapeSubtract);
+        if (!XEmptyRegion(bound_corners))
+            XShapeCombineRegion(display,
+                                m_win->window(), ShapeBounding,
+                                0, 0, // offsets
+                                bound_corners, ShapeSubtract);
     } else {
+        XSubtractRegion(clip, clip_corners, clip);
+        XSubtractRegion(bound, bound_corners, bound);
+
         XShapeCombineRegion(display,
                             m_win->window(), ShapeClip,
                             0, 0, // offsets
@@ -299,42 +303,8 @@ void Shape::update() {
 
     XDestroyRegion(clip);
     XDestroyRegion(bound);
-
-   const CornerPixmaps &corners = s_corners[m_win->screenNumber()];
-#define SHAPECORNER(corner, x, y, shapekind)            \
-    XShapeCombineMask(App::instance()->display(), \
-                      m_win->window(),                  \
-                      shapekind,                        \
-                      x, y,                             \
-                      corners.corner.drawable(),      \
-                      ShapeSubtract); 
-
-    /**
-     * Set the top corners if the y offset is nonzero.
-     */
-    if (m_shapesource == 0 || m_shapesource_yoff != 0) {
-        if (m_shapeplaces & TOPLEFT) {
-            SHAPECORNER(topleft, 0, 0, ShapeClip);
-            SHAPECORNER(topleft, -bw, -bw, ShapeBounding);
-        }
-        if (m_shapeplaces & TOPRIGHT) {
-            SHAPECORNER(topright, width-8, 0, ShapeClip);
-            SHAPECORNER(topright, width+bw-8, -bw, ShapeBounding);
-        }
-    }
-
-    // note that the bottom corners y-vals are offset by 8 (the height of the corner pixmaps)
-    if (m_shapesource == 0 || (m_shapesource_yoff+(signed) m_shapesource->height()) < height
-        || m_shapesource_yoff >= height /* shaded */) {
-        if (m_shapeplaces & BOTTOMLEFT) {
-            SHAPECORNER(botleft, 0, height-8, ShapeClip);
-            SHAPECORNER(botleft, -bw, height+bw-8, ShapeBounding);
-        }
-        if (m_shapeplaces & BOTTOMRIGHT) {
-            SHAPECORNER(botright, width-8, height-8, ShapeClip);
-            SHAPECORNER(botright, width+bw-8, height+bw-8, ShapeBounding);
-        }
-    }
+    XDestroyRegion(clip_corners);
+    XDestroyRegion(bound_corners);
 
 #endif // SHAPE
 
@@ -342,6 +312,7 @@ void Shape::update() {
 
 void Shape::setWindow(FbWindow &win) {
     m_win = &win;
+    m_applied_valid = false;
     update();
 }
 
@@ -371,6 +342,7 @@ void Shape::setShapeSource(FbWindow *win, int xoff, int yoff, bool always_update
     m_shapesource = win;
     m_shapesource_xoff = xoff;
     m_shapesource_yoff = yoff;
+    m_applied_valid = false;
     update();
 }
 
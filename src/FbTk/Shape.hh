@@ -42,7 +42,7 @@ public:
     ~Shape();
     /// set new shape places
     void setPlaces(int shapeplaces);
-    /// update our shape
+    /// update our shape, if anything it depends on changed
     void update(); 
     /// assign a new window
     void setWindow(FbWindow &win);
@@ -64,6 +64,20 @@ private:
     int m_shapesource_xoff, m_shapesource_yoff;
 
     int m_shapeplaces; ///< places to shape
+
+    /// everything the shape depends on
+    struct State {
+        bool operator == (const State &other) const;
+
+        Window window;
+        unsigned int width, height, border_width;
+        int places;
+        Window source;
+        unsigned int source_width, source_height;
+        int source_xoff, source_yoff;
+    };
+    State m_applied; ///< of the shape last set
+    bool m_applied_valid;
 };
 
 } // end namespace FbTk
@@ -25,24 +25,110 @@
 #include "RefCount.hh"
 #include "Slot.hh"
 #include <algorithm>
-#include <list>
 #include <map>
-#include <set>
+#include <vector>
 
 namespace FbTk {
 
 /// \namespace Implementation details for signals, do not use anything in this namespace
 namespace SigImpl {
 
+/**
+ * The slots connected to a signal, in the order they were connected. The
+ * first INLINE_SLOTS of them are stored inside the object itself, so
+ * signals with few slots need no allocation besides the slots and emitting
+ * reads them from one place. Each slot gets an id; ids grow with each
+ * connect, so the slots are sorted by their id.
+ */
+class SlotList {
+public:
+    typedef RefCount<SlotBase> SlotPtr;
+
+    SlotList(): m_size(0), m_next_id(0), m_buried(false) { }
+
+    size_t size() const { return m_size; }
+    const SlotPtr &slot(size_t i) const { return entry(i).slot; }
+
+    /// @return id of the new slot
+    unsigned int push_back(const SlotPtr &slot) {
+        if (m_size >= INLINE_SLOTS)
+            m_more.push_back(Entry());
+        Entry &e = entry(m_size++);
+        e.slot = slot;
+        e.id = m_next_id++;
+        return e.id;
+    }
+
+    /// @return index of the slot with 'id', or size() if there is none
+    size_t find(unsigned int id) const {
+        size_t first = 0, last = m_size;
+        while (first < last) {
+            size_t mid = first + (last - first) / 2;
+            if (entry(mid).id < id)
+                first = mid + 1;
+            else
+                last = mid;
+        }
+        return first < m_size && entry(first).id == id ? first : m_size;
+    }
+
+    /// replaces the slot at 'i' with an empty one, the tombstone
+    void bury(size_t i) {
+        SlotPtr old = entry(i).slot; // might disconnect others when destroyed
+        entry(i).slot = SlotPtr();
+        m_buried = true;
+    }
+
+    /// removes all the empty slots
+    void compact() {
+        if (!m_buried)
+            return;
+        m_buried = false;
+        size_t n = 0;
+        for (size_t i = 0; i < m_size; ++i) {
+            if (entry(i).slot == 0)
+                continue;
+            if (n != i)
+                entry(n) = entry(i);
+            ++n;
+        }
+        for (size_t i = n; i < m_size && i < INLINE_SLOTS; ++i)
+            m_inline[i].slot = SlotPtr();
+        m_more.resize(n > INLINE_SLOTS ? n - INLINE_SLOTS : 0);
+        m_size = n;
+    }
+
+private:
+    enum { INLINE_SLOTS = 4 };
+
+    struct Entry {
+        Entry(): id(0) { }
+        SlotPtr slot;
+        unsigned int id;
+    };
+
+    Entry &entry(size_t i) { return i < INLINE_SLOTS ? m_inline[i] : m_more[i - INLINE_SLOTS]; }
+    const Entry &entry(size_t i) const { return i < INLINE_SLOTS ? m_inline[i] : m_more[i - INLINE_SLOTS]; }
+
+    Entry m_inline[INLINE_SLOTS];
+    std::vector<Entry> m_more;
+    size_t m_size;
+    unsigned int m_next_id;
+    bool m_buried; ///< there are empty slots
+};
+
 /**
  * Parent class for all \c Signal template classes.
  * It handles the disconnect and holds all the slots. The connect must be
  * handled by the child class so it can do the type checking.
+ *
+ * While emitting, slots are not removed but replaced by empty ones, which
+ * are skipped and removed when the outermost emit is done. Slots connected
+ * while emitting are called by the same emit.
  */
 class SignalHolder {
 protected:
-    typedef RefCount<SlotBase> SlotPtr;
-    typedef std::list<SlotPtr> SlotList;
+    typedef SlotList::SlotPtr SlotPtr;
 
 public:
     /// Special tracker interface used by SignalTracker.
@@ -53,9 +139,7 @@ public:
         virtual void disconnect(SignalHolder& signal) = 0;
     };
 
-    typedef SlotList::iterator Iterator;
-    typedef Iterator SlotID;
-    typedef SlotList::const_iterator ConstIterator;
+    typedef unsigned int SlotID;
 
     SignalHolder() : m_emitting(0) {}
 
@@ -69,53 +153,57 @@ public:
     }
 
     /// Remove a specific slot \c id from this signal
-    void disconnect(SlotID slotIt) const {
-        if(m_emitting) {
-            // if we are emitting, we must not erase the actual element, as that would
-            // invalidate iterators in the emit() function
-            *slotIt = SlotPtr();
-        } else
-            m_slots.erase( slotIt );
+    void disconnect(SlotID id) const {
+        size_t i = m_slots.find(id);
+        if (i == m_slots.size())
+            return;
+        m_slots.bury(i);
+        if (!m_emitting)
+            m_slots.compact();
     }
 
 
     /// Removes all slots connected to this
     void clear() {
-        if(m_emitting)
-            std::fill(m_slots.begin(), m_slots.end(), SlotPtr());
-        else
-            m_slots.clear();
+        // destroyed slots might disconnect others, keep the indices valid
+        begin_emitting();
+        for (size_t i = 0; i < m_slots.size(); ++i)
+            m_slots.bury(i);
+        end_emitting();
     }
 
     void connectTracker(SignalHolder::Tracker& tracker) const {
-        m_trackers.insert(&tracker);
+        Trackers::iterator it = std::lower_bound(m_trackers.begin(), m_trackers.end(), &tracker);
+        if (it == m_trackers.end() || *it != &tracker)
+            m_trackers.insert(it, &tracker);
     }
 
     void disconnectTracker(SignalHolder::Tracker& tracker) const {
-        m_trackers.erase(&tracker);
+        Trackers::iterator it = std::lower_bound(m_trackers.begin(), m_trackers.end(), &tracker);
+        if (it != m_trackers.end() && *it == &tracker)
+            m_trackers.erase(it);
     }
 
 protected:
-    ConstIterator begin() const { return m_slots.begin(); }
-    ConstIterator end() const { return m_slots.end(); }
-
-    Iterator begin() { return m_slots.begin(); }
-    Iterator end() { return m_slots.end(); }
+    /// number of slots, including the empty ones
+    size_t numSlots() const { return m_slots.size(); }
+    /// @return the slot at 'i', or 0 if it was disconnected
+    SlotBase *slot(size_t i) const { return m_slots.slot(i).get(); }
 
     /// Connect a slot to this signal. Must only be called by child classes.
     SlotID connect(const SlotPtr& slot) const {
-        return m_slots.insert(m_slots.end(), slot);
+        return m_slots.push_back(slot);
     }
 
     void begin_emitting() { ++m_emitting; }
     void end_emitting() {
         if(--m_emitting == 0) {
             // remove elements which belonged slots that detached themselves
-            m_slots.erase(std::remove(m_slots.begin(), m_slots.end(), SlotPtr()), m_slots.end());
+            m_slots.compact();
         }
     }
 private:
-    typedef std::set<Tracker*> Trackers;
+    typedef std::vector<Tracker*> Trackers; ///< sorted
     mutable SlotList m_slots; ///< all slots connected to a signal
     mutable Trackers m_trackers; ///< all instances that tracks this signal.
     unsigned m_emitting;
@@ -130,9 +218,9 @@ class Signal: public SigImpl::SignalHolder {
 public:
     void emit(Arg1 arg1, Arg2 arg2, Arg3 arg3) {
         begin_emitting();
-        for ( Iterator it = begin(); it != end(); ++it ) {
-            if(*it)
-                static_cast<Slot<void, Arg1, Arg2, Arg3> &>(**it)(arg1, arg2, arg3);
+        for (size_t i = 0; i < numSlots(); ++i) {
+            if (SigImpl::SlotBase *s = slot(i))
+                static_cast<Slot<void, Arg1, Arg2, Arg3> &>(*s)(arg1, arg2, arg3);
         }
         end_emitting();
     }
@@ -155,9 +243,9 @@ class Signal<Arg1, Arg2, SigImpl::EmptyArg>: public SigImpl::SignalHolder {
 public:
     void emit(Arg1 arg1, Arg2 arg2) {
         begin_emitting();
-        for ( Iterator it = begin(); it != end(); ++it ) {
-            if(*it)
-                static_cast<Slot<void, Arg1, Arg2> &>(**it)(arg1, arg2);
+        for (size_t i = 0; i < numSlots(); ++i) {
+            if (SigImpl::SlotBase *s = slot(i))
+                static_cast<Slot<void, Arg1, Arg2> &>(*s)(arg1, arg2);
         }
         end_emitting();
     }
@@ -180,9 +268,9 @@ class Signal<Arg1, SigImpl::EmptyArg, SigImpl::EmptyArg>: public SigImpl::Signal
 public:
     void emit(Arg1 arg) {
         begin_emitting();
-        for ( Iterator it = begin(); it != end(); ++it ) {
-            if(*it)
-                static_cast<Slot<void, Arg1> &>(**it)(arg);
+        for (size_t i = 0; i < numSlots(); ++i) {
+            if (SigImpl::SlotBase *s = slot(i))
+                static_cast<Slot<void, Arg1> &>(*s)(arg);
         }
         end_emitting();
     }
@@ -205,9 +293,9 @@ class Signal<SigImpl::EmptyArg, SigImpl::EmptyArg, SigImpl::EmptyArg>: public Si
 public:
     void emit() {
         begin_emitting();
-        for ( Iterator it = begin(); it != end(); ++it ) {
-            if(*it)
-                static_cast<Slot<void> &>(**it)();
+        for (size_t i = 0; i < numSlots(); ++i) {
+            if (SigImpl::SlotBase *s = slot(i))
+                static_cast<Slot<void> &>(*s)();
         }
         end_emitting();
     }
@@ -0,0 +1,197 @@
+// Stats.cc
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "Stats.hh"
+
+#ifdef USE_STATS
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <ostream>
+
+namespace FbTk {
+
+namespace Stats {
+
+namespace {
+
+/// owns the histograms or counters, they live until exit
+template <typename T>
+class Registry: private NotCopyable {
+public:
+    typedef std::map<std::string, T *> Map;
+
+    Registry() { }
+    ~Registry() {
+        for (typename Map::iterator it = m_map.begin(); it != m_map.end(); ++it)
+            delete it->second;
+    }
+
+    T &get(const std::string &name) {
+        T *&item = m_map[name];
+        if (item == 0)
+            item = new T();
+        return *item;
+    }
+
+    const Map &map() const { return m_map; }
+
+    void reset() {
+        for (typename Map::iterator it = m_map.begin(); it != m_map.end(); ++it)
+            it->second->reset();
+    }
+
+private:
+    Map m_map;
+};
+
+// function statics, so they exist before any static user asks for them
+Registry<Histogram> &histograms() {
+    static Registry<Histogram> registry;
+    return registry;
+}
+
+Registry<Counter> &counters() {
+    static Registry<Counter> registry;
+    return registry;
+}
+
+} // end anonymous namespace
+
+Histogram::Histogram() {
+    reset();
+}
+
+void Histogram::reset() {
+    m_count = m_sum = m_max = 0;
+    memset(m_buckets, 0, sizeof(m_buckets));
+}
+
+unsigned int Histogram::bucket(uint64_t value) {
+
+    if (value < SUB_BUCKETS)
+        return value;
+
+#ifdef __GNUC__
+    unsigned int msb = 63 - __builtin_clzll(value);
+#else
+    unsigned int msb = SUB_BITS;
+    while (value >> (msb + 1))
+        ++msb;
+#endif
+    const unsigned int shift = msb - SUB_BITS;
+    return (shift + 1) * SUB_BUCKETS + ((value >> shift) & (SUB_BUCKETS - 1));
+}
+
+uint64_t Histogram::highest(unsigned int index) {
+
+    if (index < SUB_BUCKETS)
+        return index;
+
+    const unsigned int shift = index / SUB_BUCKETS - 1;
+    const uint64_t lowest = uint64_t(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    return lowest + ((uint64_t(1) << shift) - 1);
+}
+
+void Histogram::add(uint64_t value) {
+    ++m_count;
+    m_sum += value;
+    if (value > m_max)
+        m_max = value;
+    ++m_buckets[bucket(value)];
+}
+
+uint64_t Histogram::percentile(double percent) const {
+
+    if (m_count == 0)
+        return 0;
+
+    uint64_t wanted = uint64_t(m_count * percent / 100.0 + 0.5);
+    if (wanted == 0)
+        wanted = 1;
+
+    uint64_t seen = 0;
+    for (unsigned int i = 0; i < BUCKETS; ++i) {
+        seen += m_buckets[i];
+        if (seen >= wanted)
+            return std::min(highest(i), m_max);
+    }
+    return m_max;
+}
+
+Histogram &histogram(const std::string &name) {
+    return histograms().get(name);
+}
+
+Counter &counter(const std::string &name) {
+    return counters().get(name);
+}
+
+void dump(std::ostream &out) {
+
+    const Registry<Histogram>::Map &hists = histograms().map();
+    Registry<Histogram>::Map::const_iterator hit = hists.begin();
+
+    out << std::left << std::setw(32) << "# time in us" << std::right
+        << std::setw(10) << "count" << std::setw(10) << "mean"
+        << std::setw(10) << "p50" << std::setw(10) << "p90"
+        << std::setw(10) << "p99" << std::setw(10) << "max" << "\n";
+
+    for (; hit != hists.end(); ++hit) {
+        const Histogram &h = *hit->second;
+        if (h.count() == 0)
+            continue;
+        out << std::left << std::setw(32) << hit->first << std::right
+            << std::setw(10) << h.count()
+            << std::setw(10) << h.sum() / h.count()
+            << std::setw(10) << h.percentile(50)
+            << std::setw(10) << h.percentile(90)
+            << std::setw(10) << h.percentile(99)
+            << std::setw(10) << h.max() << "\n";
+    }
+
+    const Registry<Counter>::Map &counts = counters().map();
+    Registry<Counter>::Map::const_iterator cit = counts.begin();
+
+    out << std::left << std::setw(32) << "# counter" << std::right
+        << std::setw(10) << "count" << "\n";
+
+    for (; cit != counts.end(); ++cit) {
+        out << std::left << std::setw(32) << cit->first << std::right
+            << std::setw(10) << cit->second->count() << "\n";
+    }
+
+    out << std::flush;
+}
+
+void reset() {
+    histograms().reset();
+    counters().reset();
+}
+
+} // end namespace Stats
+
+} // end namespace FbTk
+
+#endif // USE_STATS
@@ -0,0 +1,135 @@
+// Stats.hh
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#ifndef FBTK_STATS_HH
+#define FBTK_STATS_HH
+
+#include "FbTime.hh"
+#include "NotCopyable.hh"
+
+#include <iosfwd>
+#include <string>
+
+namespace FbTk {
+
+/**
+   Counters and latency histograms to see where time is spent.
+
+   Everything is only compiled in with USE_STATS (configure --enable-stats),
+   the FBTK_STATS_* macros expand to nothing otherwise. A histogram or
+   counter is created by name on first use and stays until exit.
+*/
+namespace Stats {
+
+/**
+   Counts values (usually micro seconds) in logarithmic buckets, each
+   power of two is split in SUB_BUCKETS linear ones. So percentiles are
+   precise within 1/SUB_BUCKETS of the value, independent of its range.
+*/
+class Histogram: private NotCopyable {
+public:
+    Histogram();
+
+    void add(uint64_t value);
+    void reset();
+
+    uint64_t count() const { return m_count; }
+    uint64_t sum() const { return m_sum; }
+    uint64_t max() const { return m_max; }
+    /// @return the value 'percent' of all values are at most (within precision)
+    uint64_t percentile(double percent) const;
+
+    enum {
+        SUB_BITS = 3,
+        SUB_BUCKETS = 1 << SUB_BITS,
+        BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS
+    };
+
+    /// @return the index of the bucket 'value' is counted in
+    static unsigned int bucket(uint64_t value);
+    /// @return the highest value counted in bucket 'index'
+    static uint64_t highest(unsigned int index);
+
+private:
+    uint64_t m_count;
+    uint64_t m_sum;
+    uint64_t m_max;
+    uint32_t m_buckets[BUCKETS];
+};
+
+class Counter: private NotCopyable {
+public:
+    Counter(): m_count(0) { }
+    void add(uint64_t n = 1) { m_count += n; }
+    void reset() { m_count = 0; }
+    uint64_t count() const { return m_count; }
+private:
+    uint64_t m_count;
+};
+
+/// adds the time from construction to destruction to a histogram
+class Stopwatch: private NotCopyable {
+public:
+    explicit Stopwatch(Histogram &histogram):
+        m_histogram(histogram), m_start(FbTime::mono()) { }
+    ~Stopwatch() { m_histogram.add(FbTime::mono() - m_start); }
+private:
+    Histogram &m_histogram;
+    uint64_t m_start;
+};
+
+/// @return the histogram called 'name', created if needed
+Histogram &histogram(const std::string &name);
+/// @return the counter called 'name', created if needed
+Counter &counter(const std::string &name);
+
+/// writes all histograms (in micro seconds) and counters, sorted by name
+void dump(std::ostream &out);
+/// sets everything back to zero
+void reset();
+
+} // end namespace Stats
+
+} // end namespace FbTk
+
+#ifdef USE_STATS
+
+/// times the rest of the enclosing block, 'name' must not change
+#define FBTK_STATS_TIME(name) \
+    static FbTk::Stats::Histogram &fbtk_stats_histogram = FbTk::Stats::histogram(name); \
+    FbTk::Stats::Stopwatch fbtk_stats_stopwatch(fbtk_stats_histogram)
+
+/// adds one to the counter 'name', 'name' must not change
+#define FBTK_STATS_COUNT(name) \
+    do { \
+        static FbTk::Stats::Counter &fbtk_stats_counter = FbTk::Stats::counter(name); \
+        fbtk_stats_counter.add(); \
+    } while (0)
+
+#else
+
+#define FBTK_STATS_TIME(name)
+#define FBTK_STATS_COUNT(name) do { } while (0)
+
+#endif // USE_STATS
+
+#endif // FBTK_STATS_HH
@@ -28,6 +28,8 @@
 #include "I18n.hh"
 #include "Image.hh"
 #include "STLUtil.hh"
+#include "SimpleCommand.hh"
+#include "Debug.hh"
 
 #ifdef HAVE_CSTDIO
   #include <cstdio>
@@ -36,6 +38,8 @@
 #endif
 #include <memory>
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <algorithm>
 
 using std::cerr;
@@ -44,6 +48,66 @@ using std::string;
 
 namespace FbTk {
 
+namespace {
+
+const char CACHE_HEADER[] = "# fluxbox style cache, version 1";
+/// number of styles kept in the cache file
+const size_t MAX_CACHED_STYLES = 8;
+/// new values are written to the cache file after this delay,
+/// to save the values of all themes at once
+const uint64_t CACHE_SAVE_DELAY = 2 * FbTime::IN_SECONDS;
+
+/// FNV-1a of the content of 'filename'. styles including other
+/// files can't be cached, as their content would be missing.
+/// @return false if the file can't be read or includes other files
+bool hashFile(const string &filename, uint64_t &hash) {
+    std::ifstream infile(filename.c_str());
+    if (!infile)
+        return false;
+
+    std::ostringstream content;
+    content << infile.rdbuf();
+    const string &data = content.str();
+    if (data.find("#include") != string::npos)
+        return false;
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    // separates the content of the style from the overlay
+    hash ^= 0xff;
+    hash *= 1099511628211ULL;
+    return true;
+}
+
+/// values are on one line in the cache file
+string escape(const string &value) {
+    string result;
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (value[i] == '\\')
+            result += "\\\\";
+        else if (value[i] == '\n')
+            result += "\\n";
+        else
+            result += value[i];
+    }
+    return result;
+}
+
+string unescape(const string &value) {
+    string result;
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (value[i] == '\\' && i + 1 < value.size())
+            result += (value[++i] == 'n' ? '\n' : value[i]);
+        else
+            result += value[i];
+    }
+    return result;
+}
+
+} // end anonymous namespace
+
 struct LoadThemeHelper {
     LoadThemeHelper():m_tm(ThemeManager::instance()) {}
     void operator ()(Theme *tm) {
@@ -80,9 +144,17 @@ ThemeManager::ThemeManager():
     // max_screens: we initialize this later so we can set m_verbose
     // without having a display connection
     m_max_screens(-1),
+    m_database_loaded(false),
     m_verbose(false),
-    m_themelocation("") {
-
+    m_loading(false),
+    m_themelocation(""),
+    m_cache_read(false),
+    m_style(0) {
+
+    RefCount<Command<void> > save_cmd(new SimpleCommand<ThemeManager>(*this, &ThemeManager::saveCache));
+    m_save_timer.setCommand(save_cmd);
+    m_save_timer.setTimeout(CACHE_SAVE_DELAY);
+    m_save_timer.fireOnce(true);
 }
 
 bool ThemeManager::registerTheme(Theme &tm) {
@@ -138,23 +210,61 @@ bool ThemeManager::load(const string &filename,
         prefix = location.substr(0, location.find_last_of('/'));
     }
 
-    if (!m_database.load(location.c_str()))
-        return false;
+    string overlay_location;
+    if (!overlay_filename.empty()) {
+        overlay_location = FbTk::StringUtil::expandFilename(overlay_filename);
+        if (!FileUtil::isRegularFile(overlay_location.c_str()))
+            overlay_location = "";
+    }
 
+    uint64_t start = FbTime::mono();
+
+    // find the values of the style in the cache
+    CachedStyle *style = 0;
+    uint64_t hash = 14695981039346656037ULL;
+    if (!m_cache_file.empty() && hashFile(location, hash) &&
+        (overlay_location.empty() || hashFile(overlay_location, hash))) {
+
+        readCache();
+
+        const string files = location + '\t' + overlay_location;
+        CachedStyles::iterator it = m_cache.begin();
+        for (; it != m_cache.end() && it->files != files; ++it)
+            ;
+        if (it == m_cache.end()) {
+            it = m_cache.insert(m_cache.begin(), CachedStyle());
+            it->files = files;
+            it->hash = hash;
+            if (m_cache.size() > MAX_CACHED_STYLES)
+                m_cache.pop_back();
+        } else if (it->hash != hash) {
+            it->hash = hash;
+            it->values.clear();
+        }
+        m_cache.splice(m_cache.begin(), m_cache, it);
+        style = &m_cache.front();
+    }
 
-    if (!overlay_filename.empty()) {
-        string overlay_location = FbTk::StringUtil::expandFilename(overlay_filename);
-        if (FileUtil::isRegularFile(overlay_location.c_str())) {
-            XrmDatabaseHelper overlay_db;
-            if (overlay_db.load(overlay_location.c_str())) {
-                // after a merge the src_db is destroyed
-                // so, make sure XrmDatabaseHelper::m_database == 0
-                XrmMergeDatabases(*overlay_db, &(*m_database));
-                *overlay_db = 0;
-            }
+    const string old_location = m_location;
+    const string old_overlay_location = m_overlay_location;
+    const bool old_database_loaded = m_database_loaded;
+    m_location = location;
+    m_overlay_location = overlay_location;
+    m_database_loaded = false;
+
+    // nothing cached yet, so the style is needed anyway
+    if (style == 0 || style->values.empty()) {
+        if (!loadDatabase()) {
+            // m_database is unchanged
+            m_location = old_location;
+            m_overlay_location = old_overlay_location;
+            m_database_loaded = old_database_loaded;
+            return false;
         }
     }
 
+    m_style = style;
+
     // relies on the fact that load_rc clears search paths each time
     if (m_themelocation != "") {
         Image::removeSearchPath(m_themelocation);
@@ -173,11 +283,16 @@ bool ThemeManager::load(const string &filename,
 
     // get list and go throu all the resources and load them
     // and then reconfigure them
+    m_loading = true;
     if (screen_num < 0 || screen_num > m_max_screens) {
         STLUtil::forAll(m_themes, load_theme_helper);
     } else {
         load_theme_helper(m_themes[screen_num]);
     }
+    m_loading = false;
+
+    fbdbg << "loaded style " << m_location << (m_database_loaded ? "" : " from cache")
+          << " in " << (FbTime::mono() - start) << "us" << endl;
 
     return true;
 }
@@ -207,11 +322,9 @@ bool ThemeManager::loadItem(ThemeItem_base &resource) {
 
 /// handles resource item loading with specific name/altname
 bool ThemeManager::loadItem(ThemeItem_base &resource, const string &name, const string &alt_name) {
-    XrmValue value;
-    char *value_type;
-    if (XrmGetResource(*m_database, name.c_str(),
-                       alt_name.c_str(), &value_type, &value)) {
-        resource.setFromString(value.addr);
+    string value;
+    if (lookup(name, alt_name, value)) {
+        resource.setFromString(value.c_str());
         resource.load(&name, &alt_name); // load additional stuff by the ThemeItem
     } else
         return false;
@@ -220,13 +333,134 @@ bool ThemeManager::loadItem(ThemeItem_base &resource, const string &name, const
 }
 
 string ThemeManager::resourceValue(const string &name, const string &altname) {
-    XrmValue value;
+    string value;
+    lookup(name, altname, value);
+    return value;
+}
+
+bool ThemeManager::lookup(const string &name, const string &altname, string &value) {
+
+    string key;
+    if (m_style != 0) {
+        key = name + '\t' + altname;
+        CachedValues::const_iterator it = m_style->values.find(key);
+        if (it != m_style->values.end()) {
+            value = it->second.value;
+            return it->second.found;
+        }
+    }
+
+    // not asked for before, so the style is needed
+    if (!m_database_loaded)
+        loadDatabase();
+
+    XrmValue xrm_value;
     char *value_type;
-    if (*m_database != 0 && XrmGetResource(*m_database, name.c_str(),
-                                           altname.c_str(), &value_type, &value) && value.addr != 0)
-        return string(value.addr);
+    bool found = *m_database != 0 && XrmGetResource(*m_database, name.c_str(),
+                                                    altname.c_str(), &value_type, &xrm_value) &&
+                 xrm_value.addr != 0;
+    value = found ? xrm_value.addr : "";
+
+    if (m_style != 0) {
+        CachedValue &cached = m_style->values[key];
+        cached.found = found;
+        cached.value = value;
+        if (!m_save_timer.isTiming())
+            m_save_timer.start();
+    }
+
+    return found;
+}
+
+bool ThemeManager::loadDatabase() {
+
+    m_database_loaded = true;
+    if (!m_database.load(m_location.c_str()))
+        return false;
+
+    if (!m_overlay_location.empty()) {
+        XrmDatabaseHelper overlay_db;
+        if (overlay_db.load(m_overlay_location.c_str())) {
+            // after a merge the src_db is destroyed
+            // so, make sure XrmDatabaseHelper::m_database == 0
+            XrmMergeDatabases(*overlay_db, &(*m_database));
+            *overlay_db = 0;
+        }
+    }
+    return true;
+}
+
+void ThemeManager::readCache() {
+
+    if (m_cache_read)
+        return;
+    m_cache_read = true;
+
+    std::ifstream infile(m_cache_file.c_str());
+    string line;
+    if (!infile || !getline(infile, line) || line != CACHE_HEADER)
+        return;
+
+    // format:
+    //   style <hash> <style file>\t<overlay file>
+    //   +<name>\t<altname>\t<value>
+    //   -<name>\t<altname>
+    CachedStyle *style = 0;
+    while (getline(infile, line)) {
+        if (line.compare(0, 6, "style ") == 0) {
+            if (m_cache.size() == MAX_CACHED_STYLES)
+                break;
+            std::istringstream header(line.substr(6));
+            m_cache.push_back(CachedStyle());
+            style = &m_cache.back();
+            header >> std::hex >> style->hash;
+            header.ignore(1);
+            getline(header, style->files);
+            continue;
+        }
+
+        if (style == 0 || line.empty() || (line[0] != '+' && line[0] != '-'))
+            continue;
+
+        string::size_type tab = line.find('\t');
+        if (tab == string::npos)
+            continue;
+        tab = line.find('\t', tab + 1);
+
+        CachedValue &value = style->values[line.substr(1, tab - 1)];
+        value.found = line[0] == '+';
+        if (value.found && tab != string::npos)
+            value.value = unescape(line.substr(tab + 1));
+    }
+}
+
+void ThemeManager::saveCache() {
+
+    if (m_cache_file.empty())
+        return;
+
+    // replace the file in one go, other instances might read it
+    const string tmp_file = m_cache_file + ".tmp";
+    std::ofstream outfile(tmp_file.c_str());
+    if (!outfile)
+        return;
+
+    outfile << CACHE_HEADER << "\n";
+    CachedStyles::const_iterator it = m_cache.begin();
+    for (; it != m_cache.end(); ++it) {
+        outfile << "style " << std::hex << it->hash << std::dec << " " << it->files << "\n";
+        CachedValues::const_iterator value = it->values.begin();
+        for (; value != it->values.end(); ++value) {
+            if (value->second.found)
+                outfile << "+" << value->first << "\t" << escape(value->second.value) << "\n";
+            else
+                outfile << "-" << value->first << "\n";
+        }
+    }
 
-    return "";
+    outfile.close();
+    if (!outfile || rename(tmp_file.c_str(), m_cache_file.c_str()) != 0)
+        remove(tmp_file.c_str());
 }
 
 /*
@@ -27,10 +27,12 @@
 #define FBTK_THEME_HH
 
 #include "Signal.hh"
+#include "Timer.hh"
 #include "XrmDatabaseHelper.hh"
 
 #include <string>
 #include <list>
+#include <map>
 #include <vector>
 
 namespace FbTk {
@@ -133,6 +135,11 @@ public:
 /// Singleton theme manager
 /**
  Use this to load all the registred themes
+
+ The values looked up in a style are kept in a cache file, together with
+ a hash of the content of the style and overlay file. As long as they do
+ not change, later loads take the values from the cache and the style is
+ not parsed at all.
 */
 class ThemeManager {
 public:
@@ -150,6 +157,12 @@ public:
     bool verbose() const { return m_verbose; }
     void setVerbose(bool value) { m_verbose = value; }
 
+    /// @return true while the themes are reconfigured to a new style
+    bool loading() const { return m_loading; }
+
+    /// sets the file to cache style values in, empty disables the cache
+    void setCacheFile(const std::string &filename) { m_cache_file = filename; }
+
     // dump theme out to filename, stdout if no filename is given
     void dump(Theme& theme, const char* filename = 0) const;
     //    void listItems();
@@ -163,14 +176,45 @@ private:
     bool registerTheme(FbTk::Theme &tm);
     /// @return false if theme isn't registred in the manager
     bool unregisterTheme(FbTk::Theme &tm);
+
+    /// looks up a resource of the current style, in the cache if possible
+    bool lookup(const std::string &name, const std::string &altname, std::string &value);
+    /// loads m_database from the current style and overlay file
+    bool loadDatabase();
+    void readCache();
+    void saveCache();
+
+    struct CachedValue {
+        bool found;
+        std::string value;
+    };
+    /// key is name + '\t' + altname
+    typedef std::map<std::string, CachedValue> CachedValues;
+    struct CachedStyle {
+        std::string files;   ///< style file + '\t' + overlay file
+        uint64_t hash;       ///< of the content of the files
+        CachedValues values;
+    };
+    typedef std::list<CachedStyle> CachedStyles;
+
     /// map each theme manager to a screen
 
     ScreenThemeVector m_themes;
     int m_max_screens;
     XrmDatabaseHelper m_database;
+    bool m_database_loaded; ///< m_database tried for the current style
     bool m_verbose;
+    bool m_loading;
 
     std::string m_themelocation;
+    std::string m_location;         ///< current style file
+    std::string m_overlay_location; ///< current overlay file
+
+    std::string m_cache_file;
+    bool m_cache_read;
+    CachedStyles m_cache;     ///< most recently used first
+    CachedStyle *m_style;     ///< entry of the current style, 0 if not cached
+    Timer m_save_timer;
 };
 
 
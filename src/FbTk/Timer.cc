@@ -49,6 +49,7 @@
 #include <cstdio>
 #include <vector>
 #include <set>
+#include <map>
 
 namespace {
 
@@ -64,6 +65,9 @@ struct TimerCompare {
 typedef std::set<FbTk::Timer*, TimerCompare> TimerList;
 TimerList s_timerlist;
 
+typedef std::map<int, FbTk::RefCount<FbTk::Slot<void> > > ReadableList;
+ReadableList s_readables;
+
 }
 
 
@@ -148,6 +152,14 @@ void Timer::fireTimeout() {
 }
 
 
+void Timer::addReadable(int fd, const RefCount<Slot<void> > &handler) {
+    s_readables[fd] = handler;
+}
+
+void Timer::removeReadable(int fd) {
+    s_readables.erase(fd);
+}
+
 void Timer::updateTimers(int fd) {
 
     fd_set              rfds;
@@ -156,10 +168,17 @@ void Timer::updateTimers(int fd) {
     TimerList::iterator t;
     bool                overdue = false;
     uint64_t            now;
+    int                 maxfd = fd;
+    ReadableList::iterator r;
 
 
     FD_ZERO(&rfds);
     FD_SET(fd, &rfds);
+    for (r = s_readables.begin(); r != s_readables.end(); ++r) {
+        FD_SET(r->first, &rfds);
+        if (r->first > maxfd)
+            maxfd = r->first;
+    }
     tout = NULL;
 
     // search for overdue timers
@@ -182,9 +201,27 @@ void Timer::updateTimers(int fd) {
     // if not overdue, wait for the next xevent via the blocking
     // select(), so OS sends fluxbox to sleep. the select() will
     // time out when the next timer has to be handled
-    if (!overdue && select(fd + 1, &rfds, 0, 0, tout) != 0) {
-        // didn't time out! x events are pending
-        return;
+    if (!overdue) {
+        int ready = select(maxfd + 1, &rfds, 0, 0, tout);
+        if (ready > 0) {
+            // the handlers might add or remove readables
+            std::vector<int> fds;
+            for (r = s_readables.begin(); r != s_readables.end(); ++r) {
+                if (FD_ISSET(r->first, &rfds))
+                    fds.push_back(r->first);
+            }
+            for (size_t i = 0; i < fds.size(); ++i) {
+                r = s_readables.find(fds[i]);
+                if (r != s_readables.end()) {
+                    RefCount<Slot<void> > handler = r->second;
+                    (*handler)();
+                }
+            }
+        }
+        if (ready != 0) {
+            // didn't time out! x events are pending
+            return;
+        }
     }
 
     // stoping / restarting the timers modifies the list in an upredictable
@@ -55,8 +55,17 @@ public:
     void start();
     void stop();
 
+    /**
+       waits for the next timeout or for input on 'file_descriptor' and
+       handles the timers which are due. input on the file descriptors
+       added by addReadable() is handled here as well.
+    */
     static void updateTimers(int file_descriptor);
 
+    /// calls 'handler' from updateTimers() whenever 'fd' is readable
+    static void addReadable(int fd, const RefCount<Slot<void> > &handler);
+    static void removeReadable(int fd);
+
     int isTiming() const;
     int getInterval() const { return m_interval; }
 
@@ -20,6 +20,7 @@
 // DEALINGS IN THE SOFTWARE.
 
 #include "Transparent.hh"
+#include "FbDrawable.hh"
 #include "App.hh"
 #include "I18n.hh"
 
@@ -28,6 +29,7 @@
 
 #include <iostream>
 #include <cstdio>
+#include <map>
 
 using std::cerr;
 using std::endl;
@@ -96,6 +98,69 @@ Picture createAlphaPic(Window drawable, int alpha) {
 
     return alpha_pic;
 }
+
+/// (screen, alpha) -> alpha picture, kept as long as the display is open
+typedef std::map<std::pair<int, int>, Picture> AlphaPictures;
+AlphaPictures s_alpha_pics;
+
+Picture alphaPicture(int screen_num, int alpha) {
+    Picture &pic = s_alpha_pics[std::make_pair(screen_num, alpha)];
+    if (pic == 0) {
+        Display *disp = FbTk::App::instance()->display();
+        pic = createAlphaPic(RootWindow(disp, screen_num), alpha);
+    }
+    return pic;
+}
+
+struct SourcePicture {
+    Picture picture;
+    unsigned int count;
+};
+/// source drawable -> its picture, freed when nobody uses it anymore.
+/// (an old root pixmap must not be kept alive by its picture)
+typedef std::map<Drawable, SourcePicture> SourcePictures;
+SourcePictures s_source_pics;
+
+Picture createPicture(Drawable drawable, int screen_num) {
+    Display *disp = FbTk::App::instance()->display();
+    XRenderPictFormat *format =
+        XRenderFindVisualFormat(disp, DefaultVisual(disp, screen_num));
+    if (format == 0) {
+        _FB_USES_NLS;
+        cerr<<"FbTk::Transparent: ";
+        fprintf(stderr, _FBTK_CONSOLETEXT(Error, NoRenderVisualFormat,
+                                          "Failed to find format for screen(%d)",
+                                          "XRenderFindVisualFormat failed... include %d for screen number").
+                c_str(), screen_num);
+        cerr<<endl;
+        return 0;
+    }
+    return XRenderCreatePicture(disp, drawable, format, 0, 0);
+}
+
+Picture acquireSourcePicture(Drawable source, int screen_num) {
+    SourcePictures::iterator it = s_source_pics.find(source);
+    if (it != s_source_pics.end()) {
+        it->second.count++;
+        return it->second.picture;
+    }
+
+    SourcePicture pic;
+    pic.picture = createPicture(source, screen_num);
+    pic.count = 1;
+    if (pic.picture != 0)
+        s_source_pics[source] = pic;
+    return pic.picture;
+}
+
+void releaseSourcePicture(Drawable source) {
+    SourcePictures::iterator it = s_source_pics.find(source);
+    if (it == s_source_pics.end() || --it->second.count > 0)
+        return;
+
+    XRenderFreePicture(FbTk::App::instance()->display(), it->second.picture);
+    s_source_pics.erase(it);
+}
 #endif //  HAVE_XRENDER
 
 bool s_init = false;
@@ -153,9 +218,8 @@ bool Transparent::haveComposite(bool for_real) {
 
 Transparent::Transparent(Drawable src, Drawable dest, int alpha, int screen_num):
     m_alpha_pic(0), m_src_pic(0), m_dest_pic(0),
-    m_source(src), m_dest(dest), m_alpha(alpha) {
-
-    Display *disp = FbTk::App::instance()->display();
+    m_source(src), m_dest(dest), m_alpha(alpha),
+    m_screen_num(screen_num) {
 
     // check for Extension support
     if (!s_init)
@@ -167,26 +231,19 @@ Transparent::Transparent(Drawable src, Drawable dest, int alpha, int screen_num)
 
     allocAlpha(m_alpha);
 
-    XRenderPictFormat *format =
-        XRenderFindVisualFormat(disp,
-                                DefaultVisual(disp, screen_num));
-
-    if (src != 0 && format != 0) {
-        m_src_pic = XRenderCreatePicture(disp, src, format,
-                                         0, 0);
-    }
+    if (src != 0)
+        m_src_pic = acquireSourcePicture(src, screen_num);
 
-    if (dest != 0 && format != 0) {
-        m_dest_pic = XRenderCreatePicture(disp, dest, format,
-                                          0, 0);
-    }
+    if (dest != 0)
+        m_dest_pic = createPicture(dest, screen_num);
 #endif // HAVE_XRENDER
 }
 
 Transparent::~Transparent() {
+    forgetRendered();
+
 #ifdef HAVE_XRENDER
-    if (m_alpha_pic != 0 && s_render)
-        freeAlpha();
+    freeAlpha();
 
     Display *disp = FbTk::App::instance()->display();
 
@@ -194,7 +251,7 @@ Transparent::~Transparent() {
         XRenderFreePicture(disp, m_dest_pic);
 
     if (m_src_pic != 0  && s_render)
-        XRenderFreePicture(disp, m_src_pic);
+        releaseSourcePicture(m_source);
 #endif // HAVE_XRENDER
 }
 
@@ -202,6 +259,7 @@ void Transparent::setAlpha(int alpha) {
     if (m_source == 0 || !s_render)
         return;
 
+    forgetRendered();
     freeAlpha();
     allocAlpha(alpha);
 }
@@ -222,30 +280,11 @@ void Transparent::setDest(Drawable dest, int screen_num) {
     if (m_dest == dest || !s_render)
         return;
 
-    Display *disp = FbTk::App::instance()->display();
-
     freeDest();
     // create new dest pic if we have a valid dest drawable
-    if (dest != 0) {
-
-        XRenderPictFormat *format =
-            XRenderFindVisualFormat(disp,
-                                    DefaultVisual(disp, screen_num));
-        if (format == 0) {
-            _FB_USES_NLS;
-            cerr<<"FbTk::Transparent: ";
-            fprintf(stderr,
-                    _FBTK_CONSOLETEXT(Error, NoRenderVisualFormat,
-                                      "Failed to find format for screen(%d)",
-                                      "XRenderFindVisualFormat failed... include %d for screen number").
-                    c_str(), screen_num);
-
-            cerr<<endl;
-        } else {
-            m_dest_pic = XRenderCreatePicture(disp, dest, format, 0, 0);
-        }
+    if (dest != 0)
+        m_dest_pic = createPicture(dest, screen_num);
 
-    }
     m_dest = dest;
 #endif // HAVE_XRENDER
 }
@@ -254,43 +293,24 @@ void Transparent::setSource(Drawable source, int screen_num) {
 #ifdef HAVE_XRENDER
     if (m_source == source || !s_render)
         return;
-    // save old alpha value so we can recreate new later
-    // with the same value
-    int old_alpha = m_alpha;
-    if (m_alpha_pic != 0)
-        freeAlpha();
 
-    Display *disp = FbTk::App::instance()->display();
+    forgetRendered();
 
     if (m_src_pic != 0) {
-        XRenderFreePicture(disp, m_src_pic);
+        releaseSourcePicture(m_source);
         m_src_pic = 0;
     }
 
     m_source = source;
+    m_screen_num = screen_num;
 
     // create new source pic if we have a valid source drawable
-    if (m_source != 0) {
-
-        XRenderPictFormat *format =
-            XRenderFindVisualFormat(disp,
-                                    DefaultVisual(disp, screen_num));
-        if (format == 0) {
-            _FB_USES_NLS;
-            cerr<<"FbTk::Transparent: ";
-            fprintf(stderr, _FBTK_CONSOLETEXT(Error, NoRenderVisualFormat,
-                                              "Failed to find format for screen(%d)",
-                                              "XRenderFindVisualFormat failed... include %d for screen number").
-                    c_str(), screen_num);
-            cerr<<endl;
-        } else {
-            m_src_pic = XRenderCreatePicture(disp, m_source, format,
-                                             0, 0);
-        }
-    }
+    if (m_source != 0)
+        m_src_pic = acquireSourcePicture(m_source, screen_num);
 
-    // recreate new alpha
-    allocAlpha(old_alpha);
+    // the alpha doesn't depend on the source, but needs one
+    if (m_alpha_pic == 0)
+        allocAlpha(m_alpha);
 
 #endif // HAVE_XRENDER
 }
@@ -316,23 +336,72 @@ void Transparent::render(int src_x, int src_y,
 #endif // HAVE_XRENDER
 }
 
+void Transparent::keepRendered(const FbDrawable &rendered,
+                               int src_x, int src_y,
+                               Pixmap bg_pm, unsigned long bg_color) {
+
+    Display *disp = FbTk::App::instance()->display();
+    if (m_rendered.pm != None &&
+        (m_rendered.width != rendered.width() ||
+         m_rendered.height != rendered.height()))
+        forgetRendered();
+
+    if (m_rendered.pm == None) {
+        m_rendered.pm = XCreatePixmap(disp, rendered.drawable(),
+                                      rendered.width(), rendered.height(),
+                                      rendered.depth());
+        m_rendered.width = rendered.width();
+        m_rendered.height = rendered.height();
+    }
+
+    GC gc = XCreateGC(disp, m_rendered.pm, 0, 0);
+    XCopyArea(disp, rendered.drawable(), m_rendered.pm, gc,
+              0, 0, m_rendered.width, m_rendered.height, 0, 0);
+    XFreeGC(disp, gc);
+
+    m_rendered.src_x = src_x;
+    m_rendered.src_y = src_y;
+    m_rendered.bg_pm = bg_pm;
+    m_rendered.bg_color = bg_color;
+}
+
+bool Transparent::copyRendered(const FbDrawable &dest, int src_x, int src_y,
+                               Pixmap bg_pm, unsigned long bg_color) const {
+
+    if (m_rendered.pm == None ||
+        m_rendered.src_x != src_x || m_rendered.src_y != src_y ||
+        m_rendered.width != dest.width() ||
+        m_rendered.height != dest.height() ||
+        m_rendered.bg_pm != bg_pm || m_rendered.bg_color != bg_color)
+        return false;
+
+    Display *disp = FbTk::App::instance()->display();
+    GC gc = XCreateGC(disp, dest.drawable(), 0, 0);
+    XCopyArea(disp, m_rendered.pm, dest.drawable(), gc,
+              0, 0, m_rendered.width, m_rendered.height, 0, 0);
+    XFreeGC(disp, gc);
+    return true;
+}
+
+void Transparent::forgetRendered() {
+    if (m_rendered.pm != None) {
+        XFreePixmap(FbTk::App::instance()->display(), m_rendered.pm);
+        m_rendered.pm = None;
+    }
+}
+
 void Transparent::allocAlpha(int alpha) {
 #ifdef HAVE_XRENDER
     if (m_source == 0 || !s_render)
         return;
-    if (m_alpha_pic != 0)
-        freeAlpha();
 
-    m_alpha_pic = createAlphaPic(m_source, alpha);
+    m_alpha_pic = alphaPicture(m_screen_num, alpha);
     m_alpha = alpha;
 #endif // HAVE_XRENDER
 }
 
 void Transparent::freeAlpha() {
-#ifdef HAVE_XRENDER
-    if (s_render && m_alpha_pic != 0)
-        XRenderFreePicture(FbTk::App::instance()->display(), m_alpha_pic);
-#endif // HAVE_XRENDER
+    // the picture is shared
     m_alpha_pic = 0;
     m_alpha = 255;
 }
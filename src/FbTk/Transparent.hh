@@ -26,7 +26,14 @@
 
 namespace FbTk {
 
+class FbDrawable;
+
 /// renders to drawable together with an alpha mask
+/**
+ The alpha masks are shared by all instances with the same alpha value
+ on a screen, and so are the pictures of the source drawables (usually
+ the root pixmap).
+*/
 class Transparent {
 public:
 
@@ -55,15 +62,42 @@ public:
     Drawable dest() const { return m_dest; }
     Drawable source() const { return m_source; }
 
+    /**
+       keeps a copy of 'rendered', the result of
+       render(src_x, src_y, 0, 0, width, height) onto a destination whose
+       content before was identified by (bg_pm, bg_color)
+    */
+    void keepRendered(const FbDrawable &rendered, int src_x, int src_y,
+                      Pixmap bg_pm, unsigned long bg_color);
+    /**
+       copies the kept result to dest if it was rendered with the same
+       source, alpha, position, size and background
+       @return true if it was copied, else the caller has to render
+    */
+    bool copyRendered(const FbDrawable &dest, int src_x, int src_y,
+                      Pixmap bg_pm, unsigned long bg_color) const;
+    /// drops the kept result, e.g. when the content of the source changed
+    void forgetRendered();
 
 private:
+    struct Rendered {
+        Rendered(): pm(None) { }
+        Pixmap pm;
+        int src_x, src_y;
+        unsigned int width, height;
+        Pixmap bg_pm;
+        unsigned long bg_color;
+    };
+
     void freeAlpha();
     void allocAlpha(int newval);
-    unsigned long m_alpha_pic;
-    unsigned long m_src_pic;
+    unsigned long m_alpha_pic; ///< shared, see alphaPicture()
+    unsigned long m_src_pic;   ///< shared, see acquireSourcePicture()
     unsigned long m_dest_pic;
     Drawable m_source, m_dest;
     unsigned char m_alpha;
+    int m_screen_num;
+    Rendered m_rendered; ///< see keepRendered()
 };
 
 } // end namespace  FbTk
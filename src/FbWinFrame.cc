@@ -87,7 +87,7 @@ void render(FbTk::Color &col, Pixmap &pm, unsigned int width, unsigned int heigh
         pm = None;
         col = tex.color();
     } else {
-        pm = ictl.renderImage(width, height, tex, orient);
+        pm = ictl.renderBackground(width, height, tex, orient);
     }
 
     if (tmp)
@@ -152,6 +152,7 @@ FbWinFrame::FbWinFrame(BScreen &screen, unsigned int client_depth,
 }
 
 FbWinFrame::~FbWinFrame() {
+    m_screen.unqueueRender(*this);
     removeEventHandler();
     removeAllButtons();
 }
@@ -230,11 +231,7 @@ void FbWinFrame::hide() {
 void FbWinFrame::show() {
     m_visible = true;
 
-    if (m_need_render) {
-        renderAll();
-        applyAll();
-        clearAll();
-    }
+    renderPending();
 
     if (m_tabmode == EXTERNAL && m_use_tabs)
         m_tab_container.show();
@@ -941,9 +938,16 @@ void FbWinFrame::reconfigure() {
             m_tab_container.setAlpha(alpha);
             m_window.setOpaque(opaque);
         }
-        renderAll();
-        applyAll();
-        clearAll();
+        if (FbTk::ThemeManager::instance().loading()) {
+            // the themes of a new style are reconfigured one after
+            // another, render once all of them are done
+            m_need_render = true;
+            m_screen.queueRender(*this);
+        } else {
+            renderAll();
+            applyAll();
+            clearAll();
+        }
     } else {
         m_need_render = true;
     }
@@ -1052,6 +1056,15 @@ void FbWinFrame::reconfigureTitlebar() {
     m_titlebar.raise(); // always on top
 }
 
+void FbWinFrame::renderPending() {
+    if (!m_need_render || !isVisible())
+        return;
+
+    renderAll();
+    applyAll();
+    clearAll();
+}
+
 void FbWinFrame::renderAll() {
     m_need_render = false;
 
@@ -34,6 +34,7 @@
 #include "FbTk/Shape.hh"
 #include "FbTk/Signal.hh"
 
+#include <list>
 #include <vector>
 #include <memory>
 
@@ -78,6 +79,8 @@ public:
     void hide();
     void show();
     bool isVisible() const { return m_visible; }
+    /// renders the decorations, if that was postponed
+    void renderPending();
 
     void move(int x, int y);
     void resize(unsigned int width, unsigned int height);
@@ -98,6 +98,11 @@ public:
     // so we can make nice buttons, menu entries, etc.
     /// @return icon pixmap of the focusable
     virtual const FbTk::PixmapWithMask &icon() const { return m_icon; }
+    /// @return icon pixmap fitting width x height best, might be of
+    /// another size if the focusable has no better one
+    virtual const FbTk::PixmapWithMask &icon(unsigned int width, unsigned int height) const {
+        return icon();
+    }
     /// @return title string
     virtual const FbTk::BiDiString &title() const { return m_title; }
     /// @return type ahead string
@@ -0,0 +1,596 @@
+// IPCServer.cc
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "IPCServer.hh"
+#include "fluxbox.hh"
+#include "Screen.hh"
+#include "Window.hh"
+#include "WinClient.hh"
+#include "Debug.hh"
+
+#include "FbTk/CommandParser.hh"
+#include "FbTk/MemFun.hh"
+#include "FbTk/StringUtil.hh"
+
+#ifdef HAVE_SYS_UN_H
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif // HAVE_SYS_UN_H
+
+#ifdef HAVE_CSTRING
+  #include <cstring>
+#else
+  #include <string.h>
+#endif
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using std::string;
+using std::cerr;
+using std::endl;
+
+namespace {
+
+/// output of the command being executed, 0 if none
+string *s_output = 0;
+
+} // end anonymous namespace
+
+bool IPCServer::output(const string &text) {
+    if (s_output == 0)
+        return false;
+    s_output->append(text);
+    return true;
+}
+
+#ifdef HAVE_SYS_UN_H
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace {
+
+/// longest command line accepted
+const size_t MAX_LINE = 64 * 1024;
+/// replies held back for a client which doesn't read them, and the most
+/// read from a client at once
+const size_t MAX_PENDING = 1024 * 1024;
+/// how often to retry sending to such a client, in microseconds
+const uint64_t FLUSH_RETRY = 10 * FbTk::FbTime::IN_MILLISECONDS;
+
+/// indexed by IPCServer::Event
+const char *EVENT_NAMES[] = {
+    "focus",
+    "workspace",
+    "workspacecount",
+    "workspacenames",
+    "clientlist",
+    "title",
+    "state",
+    "windowworkspace",
+    "layer",
+    "close"
+};
+
+string windowId(Window win) {
+    return "0x" + FbTk::StringUtil::number2HexString(win);
+}
+
+void setFlags(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+    // a client going away must not SIGPIPE us, see MSG_NOSIGNAL
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+}
+
+/// @return true if some process listens on 'addr'
+bool listening(const struct sockaddr_un &addr, bool &stale) {
+    stale = false;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1)
+        return false;
+    // non-blocking, a listener with a full backlog answers EAGAIN
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    int ret = connect(fd, reinterpret_cast<const struct sockaddr*>(&addr), sizeof(addr));
+    const int error = errno;
+    ::close(fd);
+    if (ret == 0 || error == EAGAIN || error == EINPROGRESS)
+        return true;
+    // a socket nobody listens on anymore
+    stale = error == ECONNREFUSED;
+    return false;
+}
+
+FbTk::RefCount<FbTk::Slot<void> > makeHandler(IPCServer &server,
+                                              void (IPCServer::*action)(int),
+                                              int fd) {
+    typedef FbTk::MemFunBind1<void, IPCServer, int> Bind;
+    return FbTk::RefCount<FbTk::Slot<void> >(
+        new FbTk::SlotImpl<Bind, void>(FbTk::MemFunBind(server, action, fd)));
+}
+
+} // end anonymous namespace
+
+IPCServer::IPCServer():
+    m_fd(-1),
+    m_subscribed(0) {
+
+    setName("ipc");
+    // nobody subscribed yet
+    disableUpdate();
+
+    m_flush_timer.setTimeout(FLUSH_RETRY);
+    m_flush_timer.fireOnce(true);
+    m_flush_timer.setFunctor(FbTk::MemFun(*this, &IPCServer::flushAll));
+
+    m_event_timer.setTimeout(0);
+    m_event_timer.fireOnce(true);
+    m_event_timer.setFunctor(FbTk::MemFun(*this, &IPCServer::sendEvents));
+
+    reconfigure();
+}
+
+IPCServer::~IPCServer() {
+    close();
+}
+
+bool IPCServer::listen(const string &path) {
+
+    string filename = FbTk::StringUtil::expandFilename(path);
+    if (m_fd != -1 && filename == m_path)
+        return true;
+
+    close();
+    if (filename.empty())
+        return true;
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    if (filename.size() >= sizeof(addr.sun_path)) {
+        cerr<<"Fluxbox: IPC socket path too long: "<<filename<<endl;
+        return false;
+    }
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, filename.c_str());
+
+    // only ever replace a socket, never a file put there by mistake
+    struct stat st;
+    if (lstat(filename.c_str(), &st) == 0 && !S_ISSOCK(st.st_mode)) {
+        cerr<<"Fluxbox: IPC socket "<<filename<<" exists, but is no socket"<<endl;
+        return false;
+    }
+
+    // a left over from a previous run (or a restart) is replaced, the
+    // socket of another fluxbox (e.g. a nested one) is not
+    bool stale;
+    if (listening(addr, stale)) {
+        cerr<<"Fluxbox: IPC socket "<<filename<<" is used by another process"<<endl;
+        return false;
+    }
+    if (stale)
+        unlink(filename.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) {
+        cerr<<"Fluxbox: can't create IPC socket: "<<strerror(errno)<<endl;
+        return false;
+    }
+    setFlags(fd);
+
+    mode_t old_mask = umask(077);
+    int ret = bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+    umask(old_mask);
+
+    if (ret == -1 || ::listen(fd, 16) == -1) {
+        cerr<<"Fluxbox: can't listen on IPC socket "<<filename<<": "<<strerror(errno)<<endl;
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_path = filename;
+    FbTk::Timer::addReadable(m_fd,
+        FbTk::RefCount<FbTk::Slot<void> >(
+            new FbTk::SlotImpl<FbTk::MemFun0<void, IPCServer>, void>(
+                FbTk::MemFun(*this, &IPCServer::accept))));
+
+    fbdbg<<"IPCServer: listening on "<<m_path<<endl;
+    return true;
+}
+
+void IPCServer::reconfigure() {
+    listen(Fluxbox::instance()->getIPCSocketFilename());
+    // so scripts started from fluxbox know where to connect to
+    FbTk::App::setenv("FLUXBOX_IPC_SOCKET", m_path.c_str());
+}
+
+void IPCServer::close() {
+
+    while (!m_clients.empty())
+        drop(m_clients.begin()->first);
+    m_flush_timer.stop();
+
+    if (m_fd == -1)
+        return;
+
+    FbTk::Timer::removeReadable(m_fd);
+    ::close(m_fd);
+    unlink(m_path.c_str());
+    m_fd = -1;
+    m_path.clear();
+}
+
+void IPCServer::accept() {
+
+    int fd;
+    while ((fd = ::accept(m_fd, 0, 0)) != -1) {
+        setFlags(fd);
+
+        Client &client = m_clients[fd];
+        client.serial = 0;
+        client.closing = false;
+        client.events = 0;
+        FbTk::Timer::addReadable(fd, makeHandler(*this, &IPCServer::readClient, fd));
+    }
+}
+
+void IPCServer::readClient(int fd) {
+
+    Clients::iterator it = m_clients.find(fd);
+    if (it == m_clients.end())
+        return;
+    Client &client = it->second;
+
+    // client.in holds no complete line. at most MAX_PENDING is read at
+    // once, the rest the next time around the main loop.
+    char buf[4096];
+    ssize_t len = 0;
+    size_t line = client.in.size();
+    for (size_t total = 0; total < MAX_PENDING &&
+         (len = read(fd, buf, sizeof(buf))) > 0; total += len) {
+
+        client.in.append(buf, len);
+
+        ssize_t i = len;
+        while (i > 0 && buf[i - 1] != '\n')
+            --i;
+        line = (i > 0 ? 0 : line) + (len - i);
+        if (line > MAX_LINE) {
+            drop(fd);
+            return;
+        }
+    }
+
+    if (len == 0 ||
+        (len == -1 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        // nothing more to come, but answer what we got
+        client.closing = true;
+        FbTk::Timer::removeReadable(fd);
+    }
+
+    // execute the batch of complete lines
+    string::size_type start = 0, end;
+    while ((end = client.in.find('\n', start)) != string::npos) {
+        execute(client, client.in.substr(start, end - start));
+        start = end + 1;
+    }
+    client.in.erase(0, start);
+
+    flush(fd);
+}
+
+void IPCServer::execute(Client &client, const string &line) {
+
+    string command = line;
+    FbTk::StringUtil::removeFirstWhitespace(command);
+    FbTk::StringUtil::removeTrailingWhitespace(command);
+    client.serial++;
+    if (command.empty() || command[0] == '#')
+        return;
+
+    const string serial = FbTk::StringUtil::number2String(client.serial);
+
+    string first, rest;
+    FbTk::StringUtil::getFirstWord(command, first, rest);
+    first = FbTk::StringUtil::toLower(first);
+    if (first == "subscribe" || first == "unsubscribe") {
+        if (subscribe(client, first, rest))
+            client.out += serial + " ok\n";
+        else
+            client.out += serial + " error unknown event\n";
+        return;
+    }
+
+    std::auto_ptr<FbTk::Command<void> > cmd(
+        FbTk::CommandParser<void>::instance().parse(command));
+    if (cmd.get() == 0) {
+        client.out += serial + " error unknown command\n";
+        return;
+    }
+
+    string output;
+    s_output = &output;
+    cmd->execute();
+    s_output = 0;
+
+    string::size_type start = 0, end;
+    while (start < output.size()) {
+        end = output.find('\n', start);
+        if (end == string::npos)
+            end = output.size();
+        client.out += serial + " data " + output.substr(start, end - start) + "\n";
+        start = end + 1;
+    }
+    client.out += serial + " ok\n";
+}
+
+bool IPCServer::subscribe(Client &client, const string &command,
+                          const string &args) {
+
+    std::vector<string> names;
+    FbTk::StringUtil::stringtok(names, FbTk::StringUtil::toLower(args), " \t");
+
+    unsigned int events = 0;
+    if (names.empty())
+        events = (1 << EV_COUNT) - 1;
+
+    for (size_t i = 0; i < names.size(); ++i) {
+        unsigned int event;
+        for (event = 0; event < EV_COUNT; ++event) {
+            if (names[i] == EVENT_NAMES[event])
+                break;
+        }
+        if (event == EV_COUNT)
+            return false;
+        events |= 1 << event;
+    }
+
+    if (command == "subscribe")
+        client.events |= events;
+    else
+        client.events &= ~events;
+
+    updateSubscribed();
+    return true;
+}
+
+bool IPCServer::flush(int fd) {
+
+    Clients::iterator it = m_clients.find(fd);
+    if (it == m_clients.end())
+        return false;
+    Client &client = it->second;
+
+    while (!client.out.empty()) {
+        ssize_t len = send(fd, client.out.data(), client.out.size(), MSG_NOSIGNAL);
+        if (len > 0) {
+            client.out.erase(0, len);
+        } else if (len == -1 && errno == EINTR) {
+            continue;
+        } else if (len == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            drop(fd);
+            return false;
+        }
+    }
+
+    if (client.out.size() > MAX_PENDING) {
+        drop(fd);
+        return false;
+    }
+
+    if (!client.out.empty()) {
+        if (!m_flush_timer.isTiming())
+            m_flush_timer.start();
+    } else if (client.closing && client.events == 0) {
+        // subscribers may just have nothing more to say
+        drop(fd);
+        return false;
+    }
+
+    return true;
+}
+
+void IPCServer::flushAll() {
+
+    // flush() might drop clients
+    std::vector<int> fds;
+    for (Clients::iterator it = m_clients.begin(); it != m_clients.end(); ++it) {
+        if (!it->second.out.empty())
+            fds.push_back(it->first);
+    }
+    for (size_t i = 0; i < fds.size(); ++i)
+        flush(fds[i]);
+}
+
+void IPCServer::drop(int fd) {
+    FbTk::Timer::removeReadable(fd);
+    ::close(fd);
+    m_clients.erase(fd);
+    updateSubscribed();
+}
+
+void IPCServer::updateSubscribed() {
+
+    m_subscribed = 0;
+    for (Clients::iterator it = m_clients.begin(); it != m_clients.end(); ++it)
+        m_subscribed |= it->second.events;
+
+    // the AtomHandler updates are only needed if someone listens
+    if (m_subscribed != 0) {
+        enableUpdate();
+    } else {
+        disableUpdate();
+        m_pending.clear();
+        m_pending_index.clear();
+        m_event_timer.stop();
+    }
+}
+
+void IPCServer::queue(Event event, unsigned long subject, const string &args) {
+
+    if ((m_subscribed & (1 << event)) == 0)
+        return;
+
+    string line = string("event ") + EVENT_NAMES[event] + " " + args + "\n";
+
+    std::pair<unsigned int, unsigned long> key(event, subject);
+    std::map<std::pair<unsigned int, unsigned long>, size_t>::iterator it =
+        m_pending_index.find(key);
+    if (it != m_pending_index.end()) {
+        // only the latest state is of interest
+        m_pending[it->second].line = line;
+        return;
+    }
+
+    Pending pending;
+    pending.event = event;
+    pending.subject = subject;
+    pending.line = line;
+    m_pending_index[key] = m_pending.size();
+    m_pending.push_back(pending);
+
+    if (!m_event_timer.isTiming())
+        m_event_timer.start();
+}
+
+void IPCServer::sendEvents() {
+
+    std::vector<int> fds;
+    for (Clients::iterator it = m_clients.begin(); it != m_clients.end(); ++it) {
+        Client &client = it->second;
+        if (client.events == 0)
+            continue;
+
+        for (size_t i = 0; i < m_pending.size(); ++i) {
+            if (client.events & (1 << m_pending[i].event))
+                client.out += m_pending[i].line;
+        }
+        if (!client.out.empty())
+            fds.push_back(it->first);
+    }
+
+    m_pending.clear();
+    m_pending_index.clear();
+
+    // flush() might drop clients
+    for (size_t i = 0; i < fds.size(); ++i)
+        flush(fds[i]);
+}
+
+void IPCServer::setupFrame(FluxboxWindow &win) {
+    join(win.titleSig(), FbTk::MemFunSelectArg1(*this, &IPCServer::titleChanged));
+}
+
+void IPCServer::titleChanged(Focusable &win) {
+
+    if (!update() || win.fbwindow() == 0)
+        return;
+
+    Window client = win.fbwindow()->clientWindow();
+    string title = win.title().logical();
+    std::replace(title.begin(), title.end(), '\n', ' ');
+    queue(EV_TITLE, client, windowId(client) + " " + title);
+}
+
+void IPCServer::updateFocusedWindow(BScreen &screen, Window win) {
+    queue(EV_FOCUS, screen.screenNumber(),
+          FbTk::StringUtil::number2String(screen.screenNumber()) + " " + windowId(win));
+}
+
+void IPCServer::updateClientList(BScreen &screen) {
+    queue(EV_CLIENTLIST, screen.screenNumber(),
+          FbTk::StringUtil::number2String(screen.screenNumber()));
+}
+
+void IPCServer::updateWorkspaceNames(BScreen &screen) {
+
+    string args = FbTk::StringUtil::number2String(screen.screenNumber());
+    const BScreen::WorkspaceNames &names = screen.getWorkspaceNames();
+    for (size_t i = 0; i < names.size(); ++i)
+        args += (i == 0 ? " " : "\t") + names[i];
+
+    queue(EV_WORKSPACENAMES, screen.screenNumber(), args);
+}
+
+void IPCServer::updateCurrentWorkspace(BScreen &screen) {
+    queue(EV_WORKSPACE, screen.screenNumber(),
+          FbTk::StringUtil::number2String(screen.screenNumber()) + " " +
+          FbTk::StringUtil::number2String(screen.currentWorkspaceID()));
+}
+
+void IPCServer::updateWorkspaceCount(BScreen &screen) {
+    queue(EV_WORKSPACECOUNT, screen.screenNumber(),
+          FbTk::StringUtil::number2String(screen.screenNumber()) + " " +
+          FbTk::StringUtil::number2String(screen.numberOfWorkspaces()));
+}
+
+void IPCServer::updateClientClose(WinClient &winclient) {
+    queue(EV_CLOSE, winclient.window(), windowId(winclient.window()));
+}
+
+void IPCServer::updateWorkspace(FluxboxWindow &win) {
+    queue(EV_WINDOWWORKSPACE, win.clientWindow(),
+          windowId(win.clientWindow()) + " " +
+          FbTk::StringUtil::number2String(win.workspaceNumber()));
+}
+
+void IPCServer::updateState(FluxboxWindow &win) {
+
+    string args = windowId(win.clientWindow());
+    if (win.isIconic())
+        args += " iconic";
+    if (win.isMaximized())
+        args += " maximized";
+    else if (win.isMaximizedVert())
+        args += " maximizedvert";
+    else if (win.isMaximizedHorz())
+        args += " maximizedhorz";
+    if (win.isShaded())
+        args += " shaded";
+    if (win.isStuck())
+        args += " stuck";
+    if (win.isFullscreen())
+        args += " fullscreen";
+
+    queue(EV_STATE, win.clientWindow(), args);
+}
+
+void IPCServer::updateLayer(FluxboxWindow &win) {
+    queue(EV_LAYER, win.clientWindow(),
+          windowId(win.clientWindow()) + " " +
+          FbTk::StringUtil::number2String(win.layerNum()));
+}
+
+#endif // HAVE_SYS_UN_H
@@ -0,0 +1,169 @@
+// IPCServer.hh
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef IPCSERVER_HH
+#define IPCSERVER_HH
+
+#include "AtomHandler.hh"
+
+#include "FbTk/NotCopyable.hh"
+#include "FbTk/Signal.hh"
+#include "FbTk/Timer.hh"
+
+#include <map>
+#include <string>
+#include <vector>
+
+class Focusable;
+
+/**
+   Executes fluxbox commands sent over a unix domain socket, and tells
+   clients about changes they subscribed to.
+
+   Clients send one command per line, like in the keys file. All lines
+   which arrived together are executed as a batch and answered in one go,
+   each reply line starts with the number of the command line it belongs
+   to (counted per connection, starting with 1):
+
+     <n> data <text>     output of the command, if any (several lines)
+     <n> ok              the command was executed
+     <n> error <reason>  the command was not executed
+
+   Besides the fluxbox commands, 'subscribe [<event> ...]' and
+   'unsubscribe [<event> ...]' select the events (all if none are given)
+   which are sent as
+
+     event <event> <arguments>
+
+   Events are collected until fluxbox has nothing else to do, and only
+   the last one of the same kind about the same window or screen is sent.
+
+   The server is part of the main loop, see FbTk::Timer::addReadable().
+   It is only available where unix domain sockets are (HAVE_SYS_UN_H).
+*/
+class IPCServer: public AtomHandler, private FbTk::SignalTracker,
+                 private FbTk::NotCopyable {
+public:
+    /// listens on the socket set by session.ipcSocket
+    IPCServer();
+    ~IPCServer();
+
+    /**
+       listens on the socket 'path', stops listening if 'path' is empty.
+       the socket is only accessible by the user.
+       @return true on success, else false
+    */
+    bool listen(const std::string &path);
+    const std::string &path() const { return m_path; }
+
+    /**
+       adds a line of output to the reply of the command being executed
+       @return false if the command was not sent over the socket
+    */
+    static bool output(const std::string &text);
+
+    // Functions relating to AtomHandler
+
+    void initForScreen(BScreen &screen) { }
+    void setupFrame(FluxboxWindow &win);
+    void setupClient(WinClient &winclient) { }
+
+    void updateFocusedWindow(BScreen &screen, Window win);
+    void updateClientList(BScreen &screen);
+    void updateWorkspaceNames(BScreen &screen);
+    void updateCurrentWorkspace(BScreen &screen);
+    void updateWorkspaceCount(BScreen &screen);
+    void updateWorkarea(BScreen &screen) { }
+
+    void updateFrameClose(FluxboxWindow &win) { }
+    void updateClientClose(WinClient &winclient);
+    void updateWorkspace(FluxboxWindow &win);
+    void updateState(FluxboxWindow &win);
+    void updateHints(FluxboxWindow &win) { }
+    void updateLayer(FluxboxWindow &win);
+
+    bool checkClientMessage(const XClientMessageEvent &ce,
+        BScreen * screen, WinClient * const winclient) { return false; }
+    bool propertyNotify(WinClient &winclient, Atom the_property) { return false; }
+
+    /// listens on the socket set by session.ipcSocket, if it changed
+    void reconfigure();
+
+private:
+    enum Event {
+        EV_FOCUS,
+        EV_WORKSPACE,
+        EV_WORKSPACECOUNT,
+        EV_WORKSPACENAMES,
+        EV_CLIENTLIST,
+        EV_TITLE,
+        EV_STATE,
+        EV_WINDOWWORKSPACE,
+        EV_LAYER,
+        EV_CLOSE,
+        EV_COUNT
+    };
+
+    struct Client {
+        unsigned long serial; ///< number of the last command line
+        std::string in;       ///< received, but no complete line yet
+        std::string out;      ///< replies not sent yet
+        bool closing;         ///< close after sending 'out', if not subscribed
+        unsigned int events;  ///< subscribed events, bit (1 << Event)
+    };
+    typedef std::map<int, Client> Clients;
+
+    /// an event waiting to be sent
+    struct Pending {
+        unsigned int event;
+        unsigned long subject; ///< window or screen number
+        std::string line;
+    };
+
+    void close();
+    void accept();
+    void readClient(int fd);
+    void execute(Client &client, const std::string &line);
+    bool subscribe(Client &client, const std::string &command,
+                   const std::string &args);
+    /// @return false if the client was dropped
+    bool flush(int fd);
+    void flushAll();
+    void drop(int fd);
+    void updateSubscribed();
+
+    /// queues an event, replacing a pending one about the same subject
+    void queue(Event event, unsigned long subject, const std::string &args);
+    void sendEvents();
+    void titleChanged(Focusable &win);
+
+    int m_fd;
+    std::string m_path;
+    Clients m_clients;
+    FbTk::Timer m_flush_timer; ///< retries sending to slow clients
+
+    unsigned int m_subscribed;  ///< events any client subscribed to
+    std::vector<Pending> m_pending;
+    std::map<std::pair<unsigned int, unsigned long>, size_t> m_pending_index;
+    FbTk::Timer m_event_timer;  ///< sends the pending events when idle
+};
+
+#endif // IPCSERVER_HH
@@ -150,7 +150,7 @@ void IconButton::reconfigTheme() {
     setAlpha(parent()->alpha());
 
     if (m_theme->texture().usePixmap()) {
-        m_pm.reset(m_win.screen().imageControl().renderImage(
+        m_pm.reset(m_win.screen().imageControl().renderBackground(
                            width(), height(), m_theme->texture(),
                            orientation()));
         setBackgroundPixmap(m_pm);
@@ -172,28 +172,32 @@ void IconButton::refreshEverything(bool setup) {
     Display *display = FbTk::App::instance()->display();
     int screen = m_win.screen().screenNumber();
 
-    if (m_use_pixmap && m_win.icon().pixmap().drawable() != None) {
+    unsigned int w = width();
+    unsigned int h = height();
+    FbTk::translateSize(orientation(), w, h);
+    int iconx = 1;
+    int icony = 1;
+    unsigned int neww;
+    unsigned int newh = h;
+    if (newh > 2*static_cast<unsigned>(icony))
+        newh -= 2*icony;
+    else
+        newh = 1;
+    neww = newh;
+
+    // ask for the size shown, so the icon needs no scaling here
+    const FbTk::PixmapWithMask *icon = m_use_pixmap ? &m_win.icon(neww, newh) : 0;
+
+    if (icon && icon->pixmap().drawable() != None) {
         // setup icon window
         m_icon_window.show();
-        unsigned int w = width();
-        unsigned int h = height();
-        FbTk::translateSize(orientation(), w, h);
-        int iconx = 1;
-        int icony = 1;
-        unsigned int neww;
-        unsigned int newh = h;
-        if (newh > 2*static_cast<unsigned>(icony))
-            newh -= 2*icony;
-        else
-            newh = 1;
-        neww = newh;
 
         FbTk::translateCoords(orientation(), iconx, icony, w, h);
         FbTk::translatePosition(orientation(), iconx, icony, neww, newh, 0);
 
         m_icon_window.moveResize(iconx, icony, neww, newh);
 
-        m_icon_pixmap.copy(m_win.icon().pixmap().drawable(),
+        m_icon_pixmap.copy(icon->pixmap().drawable(),
                            DefaultDepth(display, screen), screen);
         m_icon_pixmap.scale(m_icon_window.width(), m_icon_window.height());
 
@@ -209,8 +213,8 @@ void IconButton::refreshEverything(bool setup) {
         m_icon_pixmap = 0;
     }
 
-    if(m_icon_pixmap.drawable() && m_win.icon().mask().drawable() != None) {
-        m_icon_mask.copy(m_win.icon().mask().drawable(), 0, 0);
+    if(m_icon_pixmap.drawable() && icon->mask().drawable() != None) {
+        m_icon_mask.copy(icon->mask().drawable(), 0, 0);
         m_icon_mask.scale(m_icon_pixmap.width(), m_icon_pixmap.height());
         m_icon_mask.rotate(orientation());
     } else
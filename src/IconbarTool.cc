@@ -339,9 +339,6 @@ void IconbarTool::setMode(string mode) {
         m_winlist->removeSig().connect(
                     std::bind1st(FbTk::MemFun(*this, &IconbarTool::update), LIST_REMOVE)
                 );
-        m_winlist->addSig().connect(
-                    std::bind1st(FbTk::MemFun(*this, &IconbarTool::update), LIST_ORDER)
-                );
         m_winlist->resetSig().connect(FbTk::MemFunBind(
                         *this, &IconbarTool::update, LIST_RESET, static_cast<Focusable *>(0)
                     ));
@@ -387,12 +384,16 @@ void IconbarTool::update(UpdateReason reason, Focusable *win) {
     *m_rc_client_width = FbTk::Util::clamp(*m_rc_client_width, 10, 400);
     m_icon_container.setMaxSizePerClient(*m_rc_client_width);
 
+    const unsigned int width = m_icon_container.width();
+    const unsigned int height = m_icon_container.height();
+    IconButton *button = 0;
+
     // lock graphic update
     m_icon_container.setUpdateLock(true);
 
     switch(reason) {
         case LIST_ADD: case LIST_ORDER:
-            insertWindow(*win);
+            button = insertWindow(*win);
             break;
         case LIST_REMOVE:
             removeWindow(*win);
@@ -409,18 +410,19 @@ void IconbarTool::update(UpdateReason reason, Focusable *win) {
     m_icon_container.update();
     m_icon_container.showSubwindows();
 
-    // another renderTheme we hopefully shouldn't need? These renders
-    // should be done individually above
+    // buttons which changed their size rendered themselves while the
+    // container placed them. a new button gets its final size only there,
+    // so it is drawn again, otherwise its text might end up behind the icon
+    if (button)
+        renderButton(*button);
 
-    // nope, we still need it (or at least I'm not bothering to fix it yet)
-    // a new IconButton doesn't get resized properly until the
-    // m_icon_container.update() above; then, it never runs drawText() again,
-    // so text can end up behind program icons
-    renderTheme();
+    if (m_icon_container.width() != width || m_icon_container.height() != height)
+        renderEmptyTexture();
 }
 
-void IconbarTool::insertWindow(Focusable &win, int pos) {
+IconButton *IconbarTool::insertWindow(Focusable &win, int pos) {
     IconButton *button = 0;
+    IconButton *new_button = 0;
 
     IconMap::iterator icon_it = m_icons.find(&win);
     if (icon_it != m_icons.end())
@@ -429,8 +431,8 @@ void IconbarTool::insertWindow(Focusable &win, int pos) {
     if (button)
         m_icon_container.removeItem(button);
     else
-        button = makeButton(win);
-    if (!button) return;
+        button = new_button = makeButton(win);
+    if (!button) return 0;
 
     if (pos == -2) {
         pos = 0;
@@ -441,6 +443,7 @@ void IconbarTool::insertWindow(Focusable &win, int pos) {
     }
 
     m_icon_container.insertItem(button, pos);
+    return new_button;
 }
 
 void IconbarTool::reset() {
@@ -469,17 +472,7 @@ void IconbarTool::renderTheme() {
     // update button sizes before we get max width per client!
     updateSizing();
 
-    // if we dont have any icons then we should render empty texture
-    if (!m_theme.emptyTexture().usePixmap()) {
-        m_empty_pm.reset( 0 );
-        m_icon_container.setBackgroundColor(m_theme.emptyTexture().color());
-    } else {
-        m_empty_pm.reset(m_screen.imageControl().
-                          renderImage(m_icon_container.width(),
-                                      m_icon_container.height(),
-                                      m_theme.emptyTexture(), orientation()));
-        m_icon_container.setBackgroundPixmap(m_empty_pm);
-    }
+    renderEmptyTexture();
 
     m_icon_container.setAlpha(m_alpha);
 
@@ -491,6 +484,21 @@ void IconbarTool::renderTheme() {
 
 }
 
+void IconbarTool::renderEmptyTexture() {
+
+    // if we dont have any icons then we should render empty texture
+    if (!m_theme.emptyTexture().usePixmap()) {
+        m_empty_pm.reset( 0 );
+        m_icon_container.setBackgroundColor(m_theme.emptyTexture().color());
+    } else {
+        m_empty_pm.reset(m_screen.imageControl().
+                          renderBackground(m_icon_container.width(),
+                                           m_icon_container.height(),
+                                           m_theme.emptyTexture(), orientation()));
+        m_icon_container.setBackgroundPixmap(m_empty_pm);
+    }
+}
+
 void IconbarTool::renderButton(IconButton &button, bool clear) {
 
     button.setPixmap(*m_rc_use_pixmap);
@@ -81,10 +81,13 @@ private:
     /// render all buttons
     void renderTheme();
     void renderTheme(int alpha);
+    /// render the background shown where there are no buttons
+    void renderEmptyTexture();
     /// destroy all icons
     void deleteIcons();
     /// add or move a single window
-    void insertWindow(Focusable &win, int pos = -2);
+    /// @return the button, if a new one was made for the window
+    IconButton *insertWindow(Focusable &win, int pos = -2);
     /// remove a single window
     void removeWindow(Focusable &win);
     /// make a button for the window
@@ -39,6 +39,7 @@
 #include "FbTk/I18n.hh"
 #include "FbTk/AutoReloadHelper.hh"
 #include "FbTk/STLUtil.hh"
+#include "FbTk/Stats.hh"
 
 #ifdef HAVE_CCTYPE
   #include <cctype>
@@ -131,7 +132,7 @@ int extractKeyFromString(const std::string& in, const char* start_pattern, unsig
 } // end of anonymous namespace
 
 // helper class 'keytree'
-class Keys::t_key {
+class Keys::t_key: public FbTk::RefCounted {
 public:
 
     // typedefs
@@ -519,6 +520,8 @@ bool Keys::addBinding(const string &linebuffer) {
 bool Keys::doAction(int type, unsigned int mods, unsigned int key,
                     int context, WinClient *current, Time time) {
 
+    FBTK_STATS_TIME("Keys::doAction");
+
     if (!m_keylist)
         return false;
 
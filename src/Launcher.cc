@@ -0,0 +1,334 @@
+// Launcher.cc
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "Launcher.hh"
+#include "fluxbox.hh"
+#include "Debug.hh"
+
+#include "FbTk/FbTime.hh"
+#include "FbTk/Stats.hh"
+#include "FbTk/StringUtil.hh"
+#include "FbTk/Timer.hh"
+
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif // HAVE_SYS_WAIT_H
+
+#ifdef HAVE_SIGNAL_H
+#include <signal.h>
+#endif // HAVE_SIGNAL_H
+
+#if defined(HAVE_SPAWN_H) && defined(HAVE_POSIX_SPAWN)
+#include <spawn.h>
+#endif
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+
+extern char **environ;
+
+using std::string;
+using std::vector;
+using std::cerr;
+using std::endl;
+
+namespace {
+
+// the posix_spawn() of old C libraries can not start a new session
+#if defined(HAVE_SPAWN_H) && defined(HAVE_POSIX_SPAWN) && defined(POSIX_SPAWN_SETSID)
+#define USE_POSIX_SPAWN 1
+#endif
+
+volatile sig_atomic_t s_child_exited = 0;
+
+/// written to by childExited(), so select() in the main loop returns
+int s_wake_pipe[2] = { -1, -1 };
+
+void wokenUp() {
+    char buf[64];
+    while (read(s_wake_pipe[0], buf, sizeof(buf)) > 0)
+        ;
+    Launcher::reap();
+}
+
+Launcher::Children s_children;
+
+/// a command waiting for its first window
+struct Startup {
+    std::string command;
+    uint64_t start;
+};
+typedef std::map<string, Startup> Startups;
+
+/// startups by id
+Startups s_startups;
+unsigned int s_startup_serial = 0;
+
+/// applications not supporting startup notification never complete
+const uint64_t STARTUP_TIMEOUT = 30 * FbTk::FbTime::IN_SECONDS;
+
+void pruneStartups(uint64_t now) {
+    Startups::iterator it = s_startups.begin();
+    while (it != s_startups.end()) {
+        if (now - it->second.start > STARTUP_TIMEOUT)
+            s_startups.erase(it++);
+        else
+            ++it;
+    }
+}
+
+/// a unique id as recommended by the startup notification spec
+string newStartupId() {
+    return "fluxbox-" + FbTk::StringUtil::number2String(getpid()) +
+        "-" + FbTk::StringUtil::number2String(++s_startup_serial) +
+        "_TIME" + FbTk::StringUtil::number2String(Fluxbox::instance()->getLastTime());
+}
+
+/// chars with a special meaning to the shell
+const char SHELL_CHARS[] = "|&;<>()$`\\\"'*?[]#~{}\n";
+
+/// reserved words and builtins, which are no programs of their own
+const char *SHELL_WORDS[] = {
+    "!", ".", ":", "[[", "alias", "bg", "break", "builtin", "case", "cd",
+    "command", "continue", "declare", "disown", "eval", "exec", "exit",
+    "export", "fc", "fg", "for", "function", "getopts", "hash", "if",
+    "jobs", "let", "local", "popd", "pushd", "read", "readonly", "return",
+    "select", "set", "shift", "source", "time", "times", "trap", "type",
+    "typeset", "ulimit", "umask", "unalias", "unset", "until", "wait",
+    "while", "{"
+};
+
+void toArgv(const vector<string> &args, vector<char *> &argv) {
+    for (size_t i = 0; i < args.size(); ++i)
+        argv.push_back(const_cast<char *>(args[i].c_str()));
+    argv.push_back(0);
+}
+
+} // end anonymous namespace
+
+pid_t Launcher::spawn(const string &command, const string &display, int screen) {
+
+    const uint64_t start = FbTk::FbTime::mono();
+
+    vector<string> shell_args;
+    const char *shell = getenv("SHELL");
+    shell_args.push_back(shell ? shell : "/bin/sh");
+    shell_args.push_back("-c");
+    shell_args.push_back(command);
+    vector<char *> shell_argv;
+    toArgv(shell_args, shell_argv);
+
+    vector<string> args;
+    const bool use_shell = needsShell(command);
+    if (!use_shell)
+        FbTk::StringUtil::stringtok(args, command, " \t");
+    else
+        args = shell_args;
+
+    if (args.empty())
+        return -1;
+
+    vector<char *> argv;
+    toArgv(args, argv);
+
+    string startup_id;
+    if (screen >= 0)
+        startup_id = newStartupId();
+
+    // our environment, with DISPLAY pointing to the screen of the command
+    // and our startup id instead of the one we might have been given
+    const string display_var = "DISPLAY=" + display;
+    const string startup_var = "DESKTOP_STARTUP_ID=" + startup_id;
+    vector<char *> envp;
+    for (char **var = environ; var && *var; ++var) {
+        if (strncmp(*var, "DISPLAY=", 8) != 0 &&
+            strncmp(*var, "DESKTOP_STARTUP_ID=", 19) != 0)
+            envp.push_back(*var);
+    }
+    envp.push_back(const_cast<char *>(display_var.c_str()));
+    if (!startup_id.empty())
+        envp.push_back(const_cast<char *>(startup_var.c_str()));
+    envp.push_back(0);
+
+    pid_t pid = -1;
+    int error = 0;
+
+#ifdef USE_POSIX_SPAWN
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSID);
+    error = posix_spawnp(&pid, argv[0], 0, &attr, &argv[0], &envp[0]);
+    // a builtin we don't know of? the shell does, or tells what's wrong
+    if (error == ENOENT && !use_shell) {
+        argv = shell_argv;
+        error = posix_spawnp(&pid, argv[0], 0, &attr, &argv[0], &envp[0]);
+    }
+    posix_spawnattr_destroy(&attr);
+    if (error != 0)
+        pid = -1;
+#else
+    pid = fork();
+    if (pid == 0) {
+        setsid();
+        environ = &envp[0];
+        execvp(argv[0], &argv[0]);
+        if (errno == ENOENT && !use_shell)
+            execvp(shell_argv[0], &shell_argv[0]);
+        _exit(EXIT_FAILURE);
+    }
+    if (pid == -1)
+        error = errno;
+#endif // USE_POSIX_SPAWN
+
+    const uint64_t spawn_time = FbTk::FbTime::mono() - start;
+#ifdef USE_STATS
+    static FbTk::Stats::Histogram &spawn_times =
+        FbTk::Stats::histogram("Launcher::spawn");
+    spawn_times.add(spawn_time);
+#endif // USE_STATS
+
+    if (pid == -1) {
+        cerr << "fluxbox: " << argv[0] << ": " << strerror(error) << endl;
+        return -1;
+    }
+
+    Child child;
+    child.pid = pid;
+    child.command = command;
+    child.start = start;
+    s_children.push_back(child);
+
+    if (!startup_id.empty()) {
+        pruneStartups(start);
+        Startup &startup = s_startups[startup_id];
+        startup.command = command;
+        startup.start = start;
+    }
+
+    fbdbg << "Launcher: started " << pid << " (" << command << ") in "
+          << spawn_time << "us" << endl;
+
+    return pid;
+}
+
+void Launcher::init() {
+
+    if (s_wake_pipe[0] != -1 || pipe(s_wake_pipe) == -1)
+        return;
+
+    for (int i = 0; i < 2; ++i) {
+        fcntl(s_wake_pipe[i], F_SETFL, fcntl(s_wake_pipe[i], F_GETFL) | O_NONBLOCK);
+        fcntl(s_wake_pipe[i], F_SETFD, FD_CLOEXEC);
+    }
+    FbTk::Timer::addReadable(s_wake_pipe[0],
+        FbTk::RefCount<FbTk::Slot<void> >(
+            new FbTk::SlotImpl<void (*)(), void>(&wokenUp)));
+}
+
+void Launcher::childExited() {
+    s_child_exited = 1;
+    if (s_wake_pipe[1] != -1) {
+        const int saved_errno = errno;
+        // a full pipe wakes up the loop as well
+        if (write(s_wake_pipe[1], "", 1) == -1)
+            ;
+        errno = saved_errno;
+    }
+}
+
+void Launcher::reap() {
+
+    if (!s_child_exited)
+        return;
+    s_child_exited = 0;
+
+    pid_t pid;
+    while ((pid = waitpid(-1, 0, WNOHANG)) > 0) {
+        for (Children::iterator it = s_children.begin(); it != s_children.end(); ++it) {
+            if (it->pid == pid) {
+                fbdbg << "Launcher: " << pid << " (" << it->command << ") exited after "
+                      << (FbTk::FbTime::mono() - it->start) / FbTk::FbTime::IN_MILLISECONDS
+                      << "ms" << endl;
+                s_children.erase(it);
+                break;
+            }
+        }
+    }
+}
+
+bool Launcher::startupComplete(const string &id, const string &app) {
+
+    Startups::iterator it = s_startups.find(id);
+    if (it == s_startups.end())
+        return false;
+
+    const uint64_t time = FbTk::FbTime::mono() - it->second.start;
+    fbdbg << "Launcher: " << app << " (" << it->second.command << ") showed up after "
+          << time / FbTk::FbTime::IN_MILLISECONDS << "ms" << endl;
+    s_startups.erase(it);
+
+#ifdef USE_STATS
+    // one histogram per application, looked up by name as it varies
+    FbTk::Stats::histogram("startup " + (app.empty() ? string("(no WM_CLASS)") : app))
+        .add(time);
+#endif // USE_STATS
+
+    return true;
+}
+
+bool Launcher::startupPending() {
+    pruneStartups(FbTk::FbTime::mono());
+    return !s_startups.empty();
+}
+
+bool Launcher::needsShell(const string &command) {
+
+    if (command.find_first_of(SHELL_CHARS) != string::npos)
+        return true;
+
+    string::size_type first = command.find_first_not_of(" \t");
+    if (first == string::npos)
+        return false;
+    string::size_type last = command.find_first_of(" \t", first);
+    const string word = command.substr(first, last - first);
+
+    // VAR=value command
+    if (word.find('=') != string::npos)
+        return true;
+
+    for (size_t i = 0; i < sizeof(SHELL_WORDS) / sizeof(SHELL_WORDS[0]); ++i) {
+        if (word == SHELL_WORDS[i])
+            return true;
+    }
+    return false;
+}
+
+const Launcher::Children &Launcher::children() {
+    return s_children;
+}
+
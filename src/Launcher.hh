@@ -0,0 +1,92 @@
+// Launcher.hh
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef LAUNCHER_HH
+#define LAUNCHER_HH
+
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#ifdef HAVE_INTTYPES_H
+#include <inttypes.h>
+#endif // HAVE_INTTYPES_H
+
+/**
+   Starts the commands fluxbox runs (exec, the startup entries of the apps
+   file, the background setter ...) and keeps track of them until they exit.
+
+   Commands without any shell syntax are started directly, without a shell
+   in between; if there is no such program, the shell gets the command
+   after all (it might be a builtin). Where available posix_spawn() is used, which does not need
+   to copy the address space of fluxbox like fork() does. Exited children
+   are reaped from the main loop, the signal handler only takes note and
+   wakes it up through a pipe.
+
+   Commands started for a screen get a startup id in DESKTOP_STARTUP_ID.
+   Applications following the startup notification spec put it into
+   _NET_STARTUP_ID of their first window, which ties the window to the
+   command and tells how long the application took to show up.
+*/
+class Launcher {
+public:
+    struct Child {
+        pid_t pid;
+        std::string command;
+        uint64_t start; ///< FbTk::FbTime::mono() when started
+    };
+    typedef std::vector<Child> Children;
+
+    /**
+       starts a command
+       @param command the command line
+       @param display value of DISPLAY for the command
+       @param screen screen the command is started on, -1 to not track
+              its startup
+       @return pid of the new process, -1 on failure
+    */
+    static pid_t spawn(const std::string &command, const std::string &display,
+                       int screen = -1);
+
+    /**
+       ends the startup 'id' as 'app' mapped its first window, with
+       USE_STATS the time it took goes to the histogram "startup <app>"
+       @return true if 'id' was started by us and still pending
+    */
+    static bool startupComplete(const std::string &id, const std::string &app);
+    /// @return true if a command started by us may still map its first window
+    static bool startupPending();
+
+    /// lets childExited() wake up the main loop, see FbTk::Timer::addReadable()
+    static void init();
+    /// takes note of a SIGCHLD, safe to call from a signal handler
+    static void childExited();
+    /// reaps the exited children, if any
+    static void reap();
+
+    /// @return true if 'command' needs a shell to be run
+    static bool needsShell(const std::string &command);
+
+    /// the children which did not exit yet
+    static const Children &children();
+};
+
+#endif // LAUNCHER_HH
@@ -0,0 +1,439 @@
+// NetWmIcon.cc for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "NetWmIcon.hh"
+#include "Debug.hh"
+
+#include "FbTk/App.hh"
+#include "FbTk/FbWindow.hh"
+#include "FbTk/GContext.hh"
+
+#include <X11/Xatom.h>
+#include <X11/Xutil.h>
+
+#include <cstdlib>
+#include <iostream>
+
+using std::vector;
+using std::hex;
+using std::dec;
+
+namespace {
+
+/// more are not read, some clients set broken properties
+const size_t MAX_IMAGES = 32;
+
+/// scaled sizes kept per window
+const size_t MAX_SCALED = 8;
+
+/// in 32 bit units, read at once to find the headers between the pixels
+const long HEADER_CHUNK = 8192;
+
+Atom netWmIconAtom() {
+    static Atom atom = XInternAtom(FbTk::App::instance()->display(),
+                                   "_NET_WM_ICON", False);
+    return atom;
+}
+
+/* From Extended Window Manager Hints, draft 1.3:
+ *
+ * _NET_WM_ICON CARDINAL[][2+n]/32
+ *
+ * This is an array of possible icons for the client. This specification does
+ * not stipulate what size these icons should be, but individual desktop
+ * environments or toolkits may do so. The Window Manager MAY scale any of
+ * these icons to an appropriate size.
+ *
+ * This is an array of 32bit packed CARDINAL ARGB with high byte being A, low
+ * byte being B. The first two cardinals are width, height. Data is in rows,
+ * left to right and top to bottom.
+ *
+ ***
+ *
+ * NOTE: the returned data for XA_CARDINAL is long if the rfmt equals
+ * 32. sizeof(long) on 64bit machines is 8. to quote from
+ * "man XGetWindowProperty":
+ *
+ *    If the returned format is 32, the property data will be stored as
+ *    an array of longs (which in a 64-bit application will be 64-bit
+ *    values that are padded in the upper 4 bytes).
+ *
+ * this is especially true on 64bit machines when some of the clients
+ * (eg: tvtime, konqueror3) have problems to feed in the right data
+ * into the _NET_WM_ICON property. we faced some segfaults because
+ * width and height were not quite right because of ignoring 64bit
+ * behaviour on client side. */
+bool readCardinals(Window win, long offset, long length,
+                   vector<unsigned long> &values, unsigned long &bytes_after) {
+
+    Atom rtype;
+    int rfmt;
+    unsigned long nr_read;
+    unsigned long *raw_data = 0;
+
+    values.clear();
+    if (!FbTk::FbWindow::property(win, netWmIconAtom(), offset, length, False,
+                                  XA_CARDINAL, &rtype, &rfmt, &nr_read, &bytes_after,
+                                  reinterpret_cast<unsigned char**>(&raw_data)))
+        return false;
+
+    if (rtype == XA_CARDINAL && rfmt == 32 && raw_data) {
+        values.resize(nr_read);
+        for (unsigned long i = 0; i < nr_read; ++i)
+            values[i] = raw_data[i] & 0xffffffff; // use only 32bit
+    }
+
+    if (raw_data)
+        XFree(raw_data);
+
+    return rtype == XA_CARDINAL && rfmt == 32;
+}
+
+uint64_t hashPixels(const vector<unsigned long> &pixels) {
+    // FNV-1a, 64 bit
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        unsigned long value = pixels[i];
+        for (int byte = 0; byte < 4; ++byte, value >>= 8) {
+            hash ^= value & 0xff;
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+bool samePixels(const vector<unsigned int> &a, const vector<unsigned long> &b) {
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i])
+            return false;
+    }
+    return true;
+}
+
+/// converts the ARGB 'pixels' into 'icon' of size width x height
+bool render(const vector<unsigned long> &pixels,
+            unsigned long src_width, unsigned long src_height,
+            unsigned int width, unsigned int height,
+            int screen_num, FbTk::PixmapWithMask &icon) {
+
+    Display* dpy = FbTk::App::instance()->display();
+
+    // the icon will not be used by the client but by
+    // 'menu', 'iconbar', 'titlebar'. all these entities
+    // are created based upon the rootwindow and
+    // the default depth. if we would use the depth of the client
+    // here we might get into trouble (xfce4-terminal, skype ..
+    // 32bit visuals vs 24bit fluxbox entities)
+    Drawable parent = RootWindow(dpy, screen_num);
+    unsigned int depth = DefaultDepth(dpy, screen_num);
+
+    // tmp image for the pixmap
+    XImage* img_pm = XCreateImage(dpy, DefaultVisual(dpy, screen_num), depth,
+                                  ZPixmap,
+                                  0, NULL, width, height, 32, 0);
+    if (!img_pm)
+        return false;
+
+    // tmp image for the mask
+    XImage* img_mask = XCreateImage(dpy, DefaultVisual(dpy, screen_num), 1,
+                                  XYBitmap,
+                                  0, NULL, width, height, 32, 0);
+
+    if (!img_mask) {
+        XDestroyImage(img_pm);
+        return false;
+    }
+
+    // allocate some memory for the icons at client side
+    img_pm->data = static_cast<char*>(malloc(img_pm->bytes_per_line * height));
+    img_mask->data = static_cast<char*>(malloc(img_mask->bytes_per_line * height));
+
+    unsigned int rgba;
+    unsigned long pixel;
+    unsigned int x;
+    unsigned int y;
+    unsigned char r, g, b, a;
+
+    for (y = 0; y < height; y++) {
+        // nearest source pixel
+        const unsigned long *src = &pixels[(y * src_height / height) * src_width];
+        for (x = 0; x < width; x++) {
+
+            rgba = src[x * src_width / width];
+
+            a = ( rgba & 0xff000000 ) >> 24;
+            r = ( rgba & 0x00ff0000 ) >> 16;
+            g = ( rgba & 0x0000ff00 ) >> 8;
+            b = ( rgba & 0x000000ff );
+
+            // 15 bit display, 5R 5G 5B
+            if (img_pm->red_mask == 0x7c00
+                && img_pm->green_mask == 0x03e0
+                && img_pm->blue_mask == 0x1f) {
+
+                pixel = ((r << 7) & 0x7c00) | ((g << 2) & 0x03e0) | ((b >> 3) & 0x001f);
+
+            // 16 bit display, 5R 6G 5B
+            } else if (img_pm->red_mask == 0xf800
+                       && img_pm->green_mask == 0x07e0
+                       && img_pm->blue_mask == 0x1f) {
+
+                pixel = ((r << 8) & 0xf800) | ((g << 3) & 0x07e0) | ((b >> 3) & 0x001f);
+
+            // 24/32 bit display, 8R 8G 8B
+            } else if (img_pm->red_mask == 0xff0000
+                       && img_pm->green_mask == 0xff00
+                       && img_pm->blue_mask == 0xff) {
+
+                pixel = rgba & 0x00ffffff;
+
+            } else {
+                pixel = 0;
+            }
+
+            // transfer rgb data
+            XPutPixel(img_pm, x, y, pixel);
+
+            // transfer mask data
+            XPutPixel(img_mask, x, y, a > 127 ? 0 : 1);
+        }
+    }
+
+    // the final icon
+    icon.pixmap().create(parent, width, height, depth);
+    icon.mask().create(parent, width, height, 1);
+
+    FbTk::GContext gc_pm(icon.pixmap());
+    FbTk::GContext gc_mask(icon.mask());
+
+    XPutImage(dpy, icon.pixmap().drawable(), gc_pm.gc(), img_pm, 0, 0, 0, 0, width, height);
+    XPutImage(dpy, icon.mask().drawable(), gc_mask.gc(), img_mask, 0, 0, 0, 0, width, height);
+
+    XDestroyImage(img_pm);   // frees img_pm->data as well
+    XDestroyImage(img_mask); // frees img_mask->data as well
+
+    return true;
+}
+
+} // end anonymous namespace
+
+NetWmIcon::SharedIcons NetWmIcon::s_shared;
+
+bool NetWmIcon::Key::operator < (const Key &other) const {
+    if (hash != other.hash)
+        return hash < other.hash;
+    if (screen_num != other.screen_num)
+        return screen_num < other.screen_num;
+    if (image_width != other.image_width)
+        return image_width < other.image_width;
+    if (image_height != other.image_height)
+        return image_height < other.image_height;
+    if (width != other.width)
+        return width < other.width;
+    return height < other.height;
+}
+
+NetWmIcon::NetWmIcon(Window win, int screen_num):
+    m_window(win),
+    m_screen_num(screen_num),
+    m_sizes_read(false),
+    m_uses(0) {
+
+}
+
+NetWmIcon::~NetWmIcon() {
+    release();
+}
+
+void NetWmIcon::reset() {
+    release();
+    m_images.clear();
+    m_sizes_read = false;
+}
+
+bool NetWmIcon::empty() {
+    if (!m_sizes_read)
+        readSizes();
+    return m_images.empty();
+}
+
+const FbTk::PixmapWithMask &NetWmIcon::icon(unsigned int width, unsigned int height) {
+
+    Image *image = bestFit(width, height);
+    if (image == 0)
+        return m_none;
+
+    if (width == 0 || height == 0) {
+        width = image->width;
+        height = image->height;
+    }
+
+    ++m_uses;
+    Scaled::iterator it = m_scaled.find(Size(width, height));
+    if (it != m_scaled.end()) {
+        it->second.last_use = m_uses;
+        return it->second.shared->second.icon;
+    }
+
+    if (m_scaled.size() >= MAX_SCALED) {
+        // make room by dropping the size not asked for the longest
+        Scaled::iterator oldest = m_scaled.begin();
+        for (it = m_scaled.begin(); it != m_scaled.end(); ++it) {
+            if (it->second.last_use < oldest->second.last_use)
+                oldest = it;
+        }
+        unshare(oldest->second.shared);
+        m_scaled.erase(oldest);
+    }
+
+    Use use;
+    if (!create(*image, width, height, use.shared))
+        return m_none;
+
+    use.last_use = m_uses;
+    m_scaled[Size(width, height)] = use;
+    return use.shared->second.icon;
+}
+
+void NetWmIcon::readSizes() {
+
+    m_sizes_read = true;
+    m_images.clear();
+
+    // only the headers of the icons are needed, the pixels are read later.
+    // the headers lie between the pixels, so a chunk is read and all the
+    // headers in it are taken, the next chunk only if a header lies beyond
+    vector<unsigned long> chunk;
+    long chunk_offset = 0;
+    long chunk_end = 0;
+    unsigned long bytes_left = 0; // after the chunk
+    long offset = 0;
+
+    while (m_images.size() < MAX_IMAGES) {
+
+        if (offset + 2 > chunk_end) {
+            if (!readCardinals(m_window, offset, HEADER_CHUNK, chunk, bytes_left) ||
+                chunk.size() < 2)
+                break;
+            chunk_offset = offset;
+            chunk_end = chunk_offset + chunk.size();
+        }
+
+        Image image;
+        image.width = chunk[offset - chunk_offset];
+        image.height = chunk[offset - chunk_offset + 1];
+        image.offset = offset + 2;
+
+        // check also for invalid values coming in from "bad" applications
+        const unsigned long nr_pixels = chunk_end - image.offset + bytes_left / 4;
+        if (image.width == 0 || image.height == 0 ||
+            image.width > nr_pixels || image.height > nr_pixels / image.width) {
+
+            fbdbg << "NetWmIcon found strange _NET_WM_ICON dimensions ("
+                  << image.width << "x" << image.height << ") for 0x"
+                  << hex << m_window << dec << "\n";
+            break;
+        }
+
+        m_images.push_back(image);
+
+        const unsigned long size = image.width * image.height;
+        if (size == nr_pixels)
+            break;
+        offset = image.offset + size;
+    }
+}
+
+NetWmIcon::Image *NetWmIcon::bestFit(unsigned int width, unsigned int height) {
+
+    if (!m_sizes_read)
+        readSizes();
+
+    // the smallest one at least as big as asked for, else the biggest
+    Image *best = 0;
+    Image *biggest = 0;
+    for (size_t i = 0; i < m_images.size(); ++i) {
+        Image &image = m_images[i];
+        const unsigned long area = image.width * image.height;
+
+        if (biggest == 0 || area > biggest->width * biggest->height)
+            biggest = &image;
+
+        if (image.width >= width && image.height >= height &&
+            (best == 0 || area < best->width * best->height))
+            best = &image;
+    }
+
+    return best ? best : biggest;
+}
+
+bool NetWmIcon::create(const Image &image, unsigned int width, unsigned int height,
+                       SharedIcons::iterator &it) {
+
+    vector<unsigned long> pixels;
+    unsigned long bytes_after;
+    const unsigned long size = image.width * image.height;
+    if (!readCardinals(m_window, image.offset, size, pixels, bytes_after) ||
+        pixels.size() != size)
+        return false;
+
+    Key key;
+    key.screen_num = m_screen_num;
+    key.hash = hashPixels(pixels);
+    key.image_width = image.width;
+    key.image_height = image.height;
+    key.width = width;
+    key.height = height;
+
+    // same icon as another window
+    std::pair<SharedIcons::iterator, SharedIcons::iterator> same =
+        s_shared.equal_range(key);
+    for (it = same.first; it != same.second; ++it) {
+        if (samePixels(it->second.pixels, pixels)) {
+            ++it->second.users;
+            return true;
+        }
+    }
+
+    it = s_shared.insert(std::make_pair(key, Shared()));
+    it->second.pixels.assign(pixels.begin(), pixels.end());
+    it->second.users = 1;
+    if (!render(pixels, image.width, image.height, width, height,
+                m_screen_num, it->second.icon)) {
+        s_shared.erase(it);
+        return false;
+    }
+
+    return true;
+}
+
+void NetWmIcon::unshare(SharedIcons::iterator it) {
+    if (--it->second.users == 0)
+        s_shared.erase(it);
+}
+
+void NetWmIcon::release() {
+    for (Scaled::iterator it = m_scaled.begin(); it != m_scaled.end(); ++it)
+        unshare(it->second.shared);
+    m_scaled.clear();
+}
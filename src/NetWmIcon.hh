@@ -0,0 +1,110 @@
+// NetWmIcon.hh for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef NETWMICON_HH
+#define NETWMICON_HH
+
+#include "FbTk/PixmapWithMask.hh"
+#include "FbTk/NotCopyable.hh"
+
+#include <map>
+#include <vector>
+
+#ifdef HAVE_INTTYPES_H
+#include <inttypes.h>
+#endif // HAVE_INTTYPES_H
+
+/**
+   The icons a client offers in _NET_WM_ICON.
+
+   Nothing is read before an icon is asked for. Then only the sizes of the
+   icons are read, and the pixels of the one fitting best; it is scaled to
+   the requested size and kept for the next time. Windows with identical
+   icons (e.g. of the same application) share the pixmaps; icons are found
+   by a hash of their pixels, which are compared before sharing.
+*/
+class NetWmIcon: private FbTk::NotCopyable {
+public:
+    NetWmIcon(Window win, int screen_num);
+    ~NetWmIcon();
+
+    /// forgets everything read so far, the property changed
+    void reset();
+
+    /// @return true if there is no usable icon
+    bool empty();
+
+    /**
+       @return the icon fitting width x height best, scaled to that size.
+       0 x 0 gives the smallest icon in its own size.
+    */
+    const FbTk::PixmapWithMask &icon(unsigned int width, unsigned int height);
+
+private:
+    /// an icon in _NET_WM_ICON
+    struct Image {
+        unsigned long width, height;
+        long offset;          ///< of the pixels, in 32 bit units
+    };
+
+    /// identifies a scaled icon shared between windows
+    struct Key {
+        int screen_num;
+        uint64_t hash; ///< of the pixels
+        unsigned long image_width, image_height;
+        unsigned int width, height;
+        bool operator < (const Key &other) const;
+    };
+    struct Shared {
+        FbTk::PixmapWithMask icon;
+        std::vector<unsigned int> pixels; ///< the icon was rendered from
+        unsigned int users;
+    };
+    /// icons with different pixels but the same hash have the same key
+    typedef std::multimap<Key, Shared> SharedIcons;
+    typedef std::pair<unsigned int, unsigned int> Size;
+    /// a scaled icon used by this window
+    struct Use {
+        SharedIcons::iterator shared;
+        unsigned long last_use; ///< value of m_uses when last asked for
+    };
+    typedef std::map<Size, Use> Scaled;
+
+    void readSizes();
+    Image *bestFit(unsigned int width, unsigned int height);
+    bool create(const Image &image, unsigned int width, unsigned int height,
+                SharedIcons::iterator &it);
+    /// drops one user of 'it', and the icon with the last one
+    static void unshare(SharedIcons::iterator it);
+    void release();
+
+    Window m_window;
+    int m_screen_num;
+    bool m_sizes_read;
+    std::vector<Image> m_images;
+    Scaled m_scaled;
+    unsigned long m_uses; ///< number of icons asked for
+    FbTk::PixmapWithMask m_none;
+
+    static SharedIcons s_shared;
+};
+
+#endif // NETWMICON_HH
@@ -0,0 +1,87 @@
+// OutlineWindow.cc
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "OutlineWindow.hh"
+
+#include "FbTk/Color.hh"
+
+namespace {
+
+void setupSide(FbTk::FbWindow &side) {
+    // white line with a black border, to be seen on any background
+    side.setBackgroundColor(FbTk::Color("white", side.screenNumber()));
+    side.setBorderColor(FbTk::Color("black", side.screenNumber()));
+    side.setBorderWidth(1);
+}
+
+} // end anonymous namespace
+
+OutlineWindow::OutlineWindow(const FbTk::FbWindow &parent):
+    m_left(parent, 0, 0, 1, 1, 0, true, true),
+    m_top(parent, 0, 0, 1, 1, 0, true, true),
+    m_right(parent, 0, 0, 1, 1, 0, true, true),
+    m_bottom(parent, 0, 0, 1, 1, 0, true, true),
+    m_visible(false) {
+
+    setupSide(m_left);
+    setupSide(m_top);
+    setupSide(m_right);
+    setupSide(m_bottom);
+}
+
+void OutlineWindow::show(int x, int y, unsigned int width, unsigned int height) {
+
+    // each side is 3 pixels wide including its border, centered on the
+    // line of the outline
+    const unsigned int w = width + 1;
+    const unsigned int h = height + 1;
+    m_top.moveResize(x - 1, y - 1, w, 1);
+    m_bottom.moveResize(x - 1, y + h - 2, w, 1);
+    m_left.moveResize(x - 1, y - 1, 1, h);
+    m_right.moveResize(x + w - 2, y - 1, 1, h);
+
+    // windows mapped meanwhile (e.g. after changing the workspace) would
+    // hide the outline otherwise
+    m_top.raise();
+    m_bottom.raise();
+    m_left.raise();
+    m_right.raise();
+
+    if (!m_visible) {
+        m_top.show();
+        m_bottom.show();
+        m_left.show();
+        m_right.show();
+        m_visible = true;
+    }
+}
+
+void OutlineWindow::hide() {
+
+    if (!m_visible)
+        return;
+
+    m_top.hide();
+    m_bottom.hide();
+    m_left.hide();
+    m_right.hide();
+    m_visible = false;
+}
@@ -0,0 +1,50 @@
+// OutlineWindow.hh
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef OUTLINEWINDOW_HH
+#define OUTLINEWINDOW_HH
+
+#include "FbTk/FbWindow.hh"
+#include "FbTk/NotCopyable.hh"
+
+/**
+   The outline of a window while it is moved or resized without opaque
+   move. Instead of xor'ing a rectangle onto the root window, which needs
+   the server grabbed to not leave traces, the four sides of the rectangle
+   are small override redirect windows, so the X server takes care of
+   redrawing whatever they uncover.
+*/
+class OutlineWindow: private FbTk::NotCopyable {
+public:
+    explicit OutlineWindow(const FbTk::FbWindow &parent);
+
+    /// shows the outline around x, y, x + width, y + height (inclusive)
+    void show(int x, int y, unsigned int width, unsigned int height);
+    void hide();
+
+    bool isVisible() const { return m_visible; }
+
+private:
+    FbTk::FbWindow m_left, m_top, m_right, m_bottom;
+    bool m_visible;
+};
+
+#endif // OUTLINEWINDOW_HH
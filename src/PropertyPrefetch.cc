@@ -0,0 +1,325 @@
+// PropertyPrefetch.cc for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "PropertyPrefetch.hh"
+
+#include "FbTk/App.hh"
+
+#ifdef HAVE_XCB
+#include <X11/Xlib-xcb.h>
+#include <xcb/xcb.h>
+#endif // HAVE_XCB
+
+#include <X11/Xatom.h>
+#include <X11/Xutil.h>
+
+#ifdef HAVE_CSTDLIB
+  #include <cstdlib>
+#else
+  #include <stdlib.h>
+#endif
+#ifdef HAVE_CSTRING
+  #include <cstring>
+#else
+  #include <string.h>
+#endif
+
+namespace {
+
+#ifdef HAVE_XCB
+
+/// in 32 bit units, longer properties are read from the server when needed
+const long PREFETCH_LENGTH = 1024;
+
+/**
+   the properties read while a client is set up; _NET_WM_ICON is left out,
+   it is big and only needed once the icon is shown
+*/
+const std::vector<Atom> &prefetchAtoms(Display *disp) {
+    static std::vector<Atom> atoms;
+    if (!atoms.empty())
+        return atoms;
+
+    static const char *names[] = {
+        "WM_PROTOCOLS",
+        "WM_WINDOW_ROLE",
+        "_MOTIF_WM_HINTS",
+        "_NET_WM_NAME",
+        "_NET_WM_STATE",
+        "_NET_WM_WINDOW_TYPE",
+        "_NET_WM_STRUT",
+        "_NET_WM_DESKTOP",
+        "_NET_STARTUP_ID",
+        "_FLUXBOX_GROUP_LEFT",
+        "_KDE_NET_WM_SYSTEM_TRAY_WINDOW_FOR",
+        "KWM_DOCKWINDOW"
+    };
+    const int num = sizeof(names) / sizeof(names[0]);
+
+    atoms.resize(num);
+    XInternAtoms(disp, const_cast<char **>(names), num, False, &atoms[0]);
+
+    atoms.push_back(XA_WM_HINTS);
+    atoms.push_back(XA_WM_NORMAL_HINTS);
+    atoms.push_back(XA_WM_CLASS);
+    atoms.push_back(XA_WM_NAME);
+    atoms.push_back(XA_WM_TRANSIENT_FOR);
+    return atoms;
+}
+
+#endif // HAVE_XCB
+
+} // end anonymous namespace
+
+PropertyPrefetch::PropertyPrefetch(Window win):
+    m_window(win),
+    m_prev_source(FbTk::FbWindow::propertySource()) {
+
+#ifdef HAVE_XCB
+    Display *disp = FbTk::App::instance()->display();
+    xcb_connection_t *conn = XGetXCBConnection(disp);
+    const std::vector<Atom> &atoms = prefetchAtoms(disp);
+
+    m_requests.resize(atoms.size());
+    for (size_t i = 0; i < atoms.size(); ++i) {
+        Request &req = m_requests[i];
+        req.atom = atoms[i];
+        req.sequence = xcb_get_property(conn, 0, win, atoms[i],
+                                        XCB_GET_PROPERTY_TYPE_ANY,
+                                        0, PREFETCH_LENGTH).sequence;
+        req.waiting = true;
+        req.valid = true;
+        req.reply = 0;
+    }
+    xcb_flush(conn);
+
+    FbTk::FbWindow::setPropertySource(this);
+#endif // HAVE_XCB
+}
+
+PropertyPrefetch::~PropertyPrefetch() {
+
+#ifdef HAVE_XCB
+    xcb_connection_t *conn = XGetXCBConnection(FbTk::App::instance()->display());
+    for (size_t i = 0; i < m_requests.size(); ++i) {
+        if (m_requests[i].waiting)
+            xcb_discard_reply(conn, m_requests[i].sequence);
+        else
+            free(m_requests[i].reply);
+    }
+
+    FbTk::FbWindow::setPropertySource(m_prev_source);
+#endif // HAVE_XCB
+}
+
+bool PropertyPrefetch::property(Window win, Atom prop,
+                                long long_offset, long long_length,
+                                Atom req_type,
+                                Atom *actual_type_return,
+                                int *actual_format_return,
+                                unsigned long *nitems_return,
+                                unsigned long *bytes_after_return,
+                                unsigned char **prop_return) {
+
+    Request *req = find(win, prop);
+    if (req == 0 || long_offset != 0) {
+        return m_prev_source != 0 &&
+            m_prev_source->property(win, prop, long_offset, long_length,
+                                    req_type, actual_type_return,
+                                    actual_format_return, nitems_return,
+                                    bytes_after_return, prop_return);
+    }
+
+#ifdef HAVE_XCB
+    if (req->waiting) {
+        xcb_connection_t *conn = XGetXCBConnection(FbTk::App::instance()->display());
+        xcb_get_property_cookie_t cookie = { req->sequence };
+        xcb_generic_error_t *error = 0;
+        req->reply = xcb_get_property_reply(conn, cookie, &error);
+        req->waiting = false;
+        // the window is gone or so, let the server tell Xlib again
+        free(error);
+    }
+
+    const xcb_get_property_reply_t *reply = req->reply;
+    if (reply == 0)
+        return false;
+
+    // same as the server would answer, see the protocol for GetProperty
+    const unsigned long fetched = xcb_get_property_value_length(reply);
+    const unsigned long total = fetched + reply->bytes_after;
+    unsigned long wanted = total;
+    if (static_cast<unsigned long>(long_length) < (total + 3) / 4)
+        wanted = 4 * long_length;
+    if (wanted > fetched)
+        return false;
+
+    *actual_type_return = reply->type;
+    *actual_format_return = reply->format;
+    *nitems_return = 0;
+    *bytes_after_return = 0;
+    *prop_return = 0;
+
+    if (reply->type == None)
+        return true;
+
+    if (req_type != AnyPropertyType && req_type != reply->type) {
+        *bytes_after_return = total;
+        wanted = 0;
+    } else {
+        *bytes_after_return = total - wanted;
+    }
+
+    // same layout as XGetWindowProperty() returns, including the
+    // trailing 0 and 32 bit values as longs
+    const unsigned long nitems = wanted / (reply->format / 8);
+    size_t size = nitems;
+    if (reply->format == 16)
+        size *= sizeof(short);
+    else if (reply->format == 32)
+        size *= sizeof(long);
+
+    unsigned char *data = static_cast<unsigned char *>(malloc(size + 1));
+    if (data == 0)
+        return false;
+
+    if (reply->format == 32) {
+        const int32_t *values =
+            static_cast<const int32_t *>(xcb_get_property_value(reply));
+        long *longs = reinterpret_cast<long *>(data);
+        for (unsigned long i = 0; i < nitems; ++i)
+            longs[i] = values[i];
+    } else {
+        memcpy(data, xcb_get_property_value(reply), size);
+    }
+    data[size] = 0;
+
+    *nitems_return = nitems;
+    *prop_return = data;
+    return true;
+#else
+    return false;
+#endif // HAVE_XCB
+}
+
+void PropertyPrefetch::invalidate(Window win, Atom prop) {
+    Request *req = find(win, prop);
+    if (req != 0)
+        req->valid = false;
+    if (m_prev_source != 0)
+        m_prev_source->invalidate(win, prop);
+}
+
+void PropertyPrefetch::windowInfo(const Window *wins, size_t num,
+                                  std::vector<WindowInfo> &info) {
+
+    Display *disp = FbTk::App::instance()->display();
+
+    info.resize(num);
+    for (size_t i = 0; i < num; ++i) {
+        info[i].window = wins[i];
+        info[i].valid = false;
+        info[i].override_redirect = false;
+        info[i].map_state = IsUnmapped;
+        info[i].icon_window = None;
+        info[i].transient_for = None;
+    }
+
+#ifdef HAVE_XCB
+    xcb_connection_t *conn = XGetXCBConnection(disp);
+
+    std::vector<xcb_get_window_attributes_cookie_t> attribs(num);
+    std::vector<xcb_get_property_cookie_t> hints(num);
+    std::vector<xcb_get_property_cookie_t> transients(num);
+    for (size_t i = 0; i < num; ++i) {
+        attribs[i] = xcb_get_window_attributes(conn, wins[i]);
+        // icon_window is the 5th field of WM_HINTS
+        hints[i] = xcb_get_property(conn, 0, wins[i], XA_WM_HINTS,
+                                    XA_WM_HINTS, 0, 5);
+        transients[i] = xcb_get_property(conn, 0, wins[i], XA_WM_TRANSIENT_FOR,
+                                         XA_WINDOW, 0, 1);
+    }
+    xcb_flush(conn);
+
+    for (size_t i = 0; i < num; ++i) {
+        WindowInfo &win = info[i];
+
+        xcb_get_window_attributes_reply_t *attrib =
+            xcb_get_window_attributes_reply(conn, attribs[i], 0);
+        if (attrib) {
+            win.valid = true;
+            win.override_redirect = attrib->override_redirect;
+            win.map_state = attrib->map_state;
+            free(attrib);
+        }
+
+        xcb_get_property_reply_t *reply = xcb_get_property_reply(conn, hints[i], 0);
+        if (reply) {
+            const uint32_t *values =
+                static_cast<const uint32_t *>(xcb_get_property_value(reply));
+            if (reply->format == 32 && xcb_get_property_value_length(reply) >= 5 * 4 &&
+                (values[0] & IconWindowHint))
+                win.icon_window = values[4];
+            free(reply);
+        }
+
+        reply = xcb_get_property_reply(conn, transients[i], 0);
+        if (reply) {
+            if (reply->format == 32 && xcb_get_property_value_length(reply) >= 4)
+                win.transient_for = *static_cast<const uint32_t *>(xcb_get_property_value(reply));
+            free(reply);
+        }
+    }
+#else
+    for (size_t i = 0; i < num; ++i) {
+        WindowInfo &win = info[i];
+
+        XWindowAttributes attrib;
+        if (XGetWindowAttributes(disp, wins[i], &attrib)) {
+            win.valid = true;
+            win.override_redirect = attrib.override_redirect;
+            win.map_state = attrib.map_state;
+        }
+
+        XWMHints *hints = XGetWMHints(disp, wins[i]);
+        if (hints) {
+            if (hints->flags & IconWindowHint)
+                win.icon_window = hints->icon_window;
+            XFree(hints);
+        }
+
+        Window transient_for;
+        if (XGetTransientForHint(disp, wins[i], &transient_for))
+            win.transient_for = transient_for;
+    }
+#endif // HAVE_XCB
+}
+
+PropertyPrefetch::Request *PropertyPrefetch::find(Window win, Atom prop) {
+    if (win != m_window)
+        return 0;
+
+    for (size_t i = 0; i < m_requests.size(); ++i) {
+        if (m_requests[i].atom == prop)
+            return m_requests[i].valid ? &m_requests[i] : 0;
+    }
+    return 0;
+}
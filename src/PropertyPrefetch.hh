@@ -0,0 +1,92 @@
+// PropertyPrefetch.hh for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef PROPERTYPREFETCH_HH
+#define PROPERTYPREFETCH_HH
+
+#include "FbTk/FbWindow.hh"
+#include "FbTk/NotCopyable.hh"
+
+#include <vector>
+
+struct xcb_get_property_reply_t;
+
+/**
+   Fetches the properties needed to set up a new client all at once.
+
+   The GetProperty requests for the client are sent together when the
+   object is created, so the replies arrive after a single round trip
+   instead of one round trip per property. While the object exists,
+   FbTk::FbWindow::property() is answered from these replies.
+
+   Without XCB nothing is fetched in advance and all properties are read
+   from the server as before.
+*/
+class PropertyPrefetch: public FbTk::FbWindow::PropertySource,
+                        private FbTk::NotCopyable {
+public:
+    explicit PropertyPrefetch(Window win);
+    ~PropertyPrefetch();
+
+    bool property(Window win, Atom property,
+                  long long_offset, long long_length,
+                  Atom req_type,
+                  Atom *actual_type_return,
+                  int *actual_format_return,
+                  unsigned long *nitems_return,
+                  unsigned long *bytes_after_return,
+                  unsigned char **prop_return);
+    void invalidate(Window win, Atom property);
+
+    /// what is needed to decide whether and when to manage a window
+    struct WindowInfo {
+        Window window;
+        bool valid;             ///< the attributes could be read
+        bool override_redirect;
+        int map_state;
+        Window icon_window;     ///< from WM_HINTS, or None
+        Window transient_for;   ///< from WM_TRANSIENT_FOR, or None
+    };
+
+    /**
+       Reads the attributes, WM_HINTS and WM_TRANSIENT_FOR of all 'wins'.
+       With XCB all requests are sent before the first reply is awaited.
+    */
+    static void windowInfo(const Window *wins, size_t num,
+                           std::vector<WindowInfo> &info);
+
+private:
+    struct Request {
+        Atom atom;
+        unsigned int sequence; ///< of the GetProperty request
+        bool waiting;          ///< for the reply
+        bool valid;            ///< property not changed by us since
+        xcb_get_property_reply_t *reply; ///< 0 on error
+    };
+
+    Request *find(Window win, Atom property);
+
+    Window m_window;
+    std::vector<Request> m_requests;
+    FbTk::FbWindow::PropertySource *m_prev_source;
+};
+
+#endif // PROPERTYPREFETCH_HH
@@ -29,6 +29,7 @@
 #include "FbMenu.hh"
 #include "MenuCreator.hh"
 #include "FbCommands.hh"
+#include "Launcher.hh"
 #include "fluxbox.hh"
 #include "Layer.hh"
 #include "Debug.hh"
@@ -275,6 +276,36 @@ string escapeRememberChars(const string& str) {
     return escaped_str;
 }
 
+// the startup id in _NET_STARTUP_ID of 'win'
+bool startupId(Window win, string &id) {
+    static Atom net_startup_id =
+        XInternAtom(FbTk::App::instance()->display(), "_NET_STARTUP_ID", False);
+
+    XTextProperty text_prop;
+    if (win == None || !FbTk::FbWindow::textProperty(win, net_startup_id, text_prop))
+        return false;
+
+    if (text_prop.value != 0) {
+        id.assign(reinterpret_cast<const char *>(text_prop.value), text_prop.nitems);
+        XFree(text_prop.value);
+    }
+    return !id.empty();
+}
+
+// ends the startup of the command which started 'winclient'
+void completeStartup(WinClient &winclient) {
+    // the client's id comes with the other prefetched properties, but
+    // the group leader would cost a round trip, so only ask if it matters
+    if (!Launcher::startupPending())
+        return;
+
+    string id;
+    if (startupId(winclient.window(), id) ||
+        (winclient.window_group != winclient.window() &&
+         startupId(winclient.window_group, id)))
+        Launcher::startupComplete(id, winclient.getWMClassName());
+}
+
 class RememberMenuItem : public FbTk::MenuItem {
 public:
     RememberMenuItem(const FbTk::BiDiString &label,
@@ -1375,6 +1406,8 @@ void Remember::setupClient(WinClient &winclient) {
     if (winclient.screen().isRestart())
         return;
 
+    completeStartup(winclient);
+
     // check if apps file has changed
     checkReload();
 
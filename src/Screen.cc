@@ -49,6 +49,8 @@
 #include "HeadArea.hh"
 #include "RectangleUtil.hh"
 #include "FbCommands.hh"
+#include "PropertyPrefetch.hh"
+#include "OutlineWindow.hh"
 #ifdef USE_SYSTRAY
 #include "SystemTray.hh"
 #endif
@@ -70,6 +72,7 @@
 #include "FbTk/STLUtil.hh"
 #include "FbTk/KeyUtil.hh"
 #include "FbTk/Util.hh"
+#include "FbTk/FbTime.hh"
 
 #ifdef USE_SLIT
 #include "Slit.hh"
@@ -122,6 +125,8 @@ extern  "C" {
 #include <iostream>
 #include <algorithm>
 #include <functional>
+#include <map>
+#include <set>
 #include <stack>
 #include <cstdarg>
 #include <cstring>
@@ -157,6 +162,10 @@ int anotherWMRunning(Display *display, XErrorEvent *) {
 }
 
 
+/// time spent on queued frames before events are handled again
+const uint64_t RENDER_QUEUE_SLICE = 10 * FbTk::FbTime::IN_MILLISECONDS;
+
+
 int calcSquareDistance(int x1, int y1, int x2, int y2) {
     return (x2-x1)*(x2-x1) + (y2-y1)*(y2-y1);
 }
@@ -208,6 +217,8 @@ BScreen::BScreen(FbTk::ResourceManager &rm,
     m_geom_window(new OSDWindow(m_root_window, *this, *m_focused_windowtheme)),
     m_pos_window(new OSDWindow(m_root_window, *this, *m_focused_windowtheme)),
     m_tooltip_window(new TooltipWindow(m_root_window, *this, *m_focused_windowtheme)),
+    m_outline_window(new OutlineWindow(m_root_window)),
+    m_refresh_interval(0),
     m_dummy_window(scrn, -1, -1, 1, 1, 0, true, false, CopyFromParent, InputOnly),
     resource(rm, screenname, altscreenname),
     m_resource_manager(rm),
@@ -224,6 +235,11 @@ BScreen::BScreen(FbTk::ResourceManager &rm,
     m_state.shutdown = false;
     m_state.managed = false;
 
+    FbTk::RefCount<FbTk::Command<void> > render_cmd(new FbTk::SimpleCommand<BScreen>(*this, &BScreen::renderQueue));
+    m_render_timer.setCommand(render_cmd);
+    m_render_timer.setTimeout(0);
+    m_render_timer.fireOnce(true);
+
     Fluxbox *fluxbox = Fluxbox::instance();
     Display *disp = fluxbox->display();
 
@@ -464,90 +480,76 @@ void BScreen::initWindows() {
     Fluxbox* fluxbox = Fluxbox::instance();
     Display* disp = fluxbox->display();
 
+    uint64_t start = FbTk::FbTime::mono();
+
     XQueryTree(disp, rootWindow().window(), &r, &p, &children, &nchild);
 
+    vector<PropertyPrefetch::WindowInfo> info;
+    PropertyPrefetch::windowInfo(children, nchild, info);
+    if (children)
+        XFree(children);
+
     // preen the window list of all icon windows... for better dockapp support
-    for (unsigned int i = 0; i < nchild; i++) {
+    std::set<Window> icon_windows;
+    for (size_t i = 0; i < info.size(); ++i) {
+        if (info[i].icon_window != None && info[i].icon_window != info[i].window)
+            icon_windows.insert(info[i].icon_window);
+    }
 
-        if (children[i] == None)
+    // index of each window we might manage
+    std::map<Window, size_t> index;
+    for (size_t i = 0; i < info.size(); ++i) {
+        if (icon_windows.count(info[i].window) != 0) {
+            fbdbg<<"BScreen::initWindows(): icon_window = 0x"<<hex<<info[i].window<<dec<<endl;
             continue;
-
-        XWMHints *wmhints = XGetWMHints(disp, children[i]);
-
-        if (wmhints) {
-            if ((wmhints->flags & IconWindowHint) &&
-                (wmhints->icon_window != children[i]))
-                for (unsigned int j = 0; j < nchild; j++) {
-                    if (children[j] == wmhints->icon_window) {
-
-                        fbdbg<<"BScreen::initWindows(): children[j] = 0x"<<hex<<children[j]<<dec<<endl;
-                        fbdbg<<"BScreen::initWindows(): = icon_window"<<endl;
-
-                        children[j] = None;
-                        break;
-                    }
-                }
-            XFree(wmhints);
         }
+        if (info[i].valid && !info[i].override_redirect)
+            index[info[i].window] = i;
     }
 
-
-    // manage shown windows
-    Window transient_for = 0;
-    bool safety_flag = false;
-    unsigned int num_transients = 0;
-    for (unsigned int i = 0; i <= nchild; ++i) {
-        if (i == nchild) {
-            if (num_transients) {
-                if (num_transients == nchild)
-                    safety_flag = true;
-                nchild = num_transients;
-                i = num_transients = 0;
-            } else
+    // order the windows, so transients are created after the window
+    // they are transient for; apart from that keep the stacking order
+    vector<size_t> order;
+    vector<int> state(info.size(), 0); // 0: not seen, 1: on the way, 2: done
+    for (size_t i = 0; i < info.size(); ++i) {
+        size_t cur = i;
+        vector<size_t> path;
+        while (index.count(info[cur].window) && state[cur] == 0) {
+            state[cur] = 1;
+            path.push_back(cur);
+            std::map<Window, size_t>::const_iterator parent =
+                index.find(info[cur].transient_for);
+            if (parent == index.end())
                 break;
+            fbdbg<<"BScreen::initWindows(): 0x"<<hex<<info[cur].window
+                 <<" is transient for 0x"<<info[cur].transient_for<<dec<<endl;
+            cur = parent->second;
         }
-
-        if (children[i] == None)
-            continue;
-        else if (!fluxbox->validateWindow(children[i])) {
-
-            fbdbg<<"BScreen::initWindows(): not valid window = "<<hex<<children[i]<<dec<<endl;
-
-            children[i] = None;
-            continue;
+        // parents were pushed last
+        for (size_t j = path.size(); j-- > 0; ) {
+            state[path[j]] = 2;
+            order.push_back(path[j]);
         }
+    }
 
-        // if we have a transient_for window and it isn't created yet...
-        // postpone creation of this window until after all others
-        if (XGetTransientForHint(disp, children[i], &transient_for) &&
-            fluxbox->searchWindow(transient_for) == 0 && !safety_flag) {
-            // add this window back to the beginning of the list of children
-            children[num_transients] = children[i];
-            num_transients++;
-
-            fbdbg<<"BScreen::initWindows(): postpone creation of 0x"<<hex<<children[i]<<dec<<endl;
-            fbdbg<<"BScreen::initWindows(): transient_for = 0x"<<hex<<transient_for<<dec<<endl;
+    // manage shown windows
+    size_t num_created = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        const PropertyPrefetch::WindowInfo &win = info[order[i]];
 
+        if (!fluxbox->validateWindow(win.window)) {
+            fbdbg<<"BScreen::initWindows(): not valid window = "<<hex<<win.window<<dec<<endl;
             continue;
         }
 
-
-        XWindowAttributes attrib;
-        if (XGetWindowAttributes(disp, children[i],
-                                 &attrib)) {
-            if (attrib.override_redirect) {
-                children[i] = None; // we dont need this anymore, since we already created a window for it
-                continue;
-            }
-
-            if (attrib.map_state != IsUnmapped)
-                createWindow(children[i]);
-
+        if (win.map_state != IsUnmapped) {
+            createWindow(win.window);
+            ++num_created;
         }
-        children[i] = None; // we dont need this anymore, since we already created a window for it
     }
 
-    XFree(children);
+    fbdbg<<"BScreen::initWindows(): adopted "<<num_created<<" of "<<info.size()
+         <<" windows in "<<(FbTk::FbTime::mono() - start) / 1000<<" ms"<<endl;
 
     // now, show slit and toolbar
 #ifdef USE_SLIT
@@ -1008,12 +1010,11 @@ bool BScreen::isKdeDockapp(Window client) const {
     Atom ajunk;
     int ijunk;
     unsigned long *data = 0, uljunk;
-    Display *disp = FbTk::App::instance()->display();
     // Check if KDE v2.x dock applet
-    if (XGetWindowProperty(disp, client, atom_kde_systray,
-                           0l, 1l, False,
-                           XA_WINDOW, &ajunk, &ijunk, &uljunk,
-                           &uljunk, (unsigned char **) &data) == Success) {
+    if (FbTk::FbWindow::property(client, atom_kde_systray,
+                                 0l, 1l, False,
+                                 XA_WINDOW, &ajunk, &ijunk, &uljunk,
+                                 &uljunk, (unsigned char **) &data)) {
 
         if (data)
             iskdedockapp = true;
@@ -1023,10 +1024,10 @@ bool BScreen::isKdeDockapp(Window client) const {
 
     // Check if KDE v1.x dock applet
     if (!iskdedockapp) {
-        if (XGetWindowProperty(disp, client,
-                               atom_kwm1, 0l, 1l, False,
-                               atom_kwm1, &ajunk, &ijunk, &uljunk,
-                               &uljunk, (unsigned char **) &data) == Success && data) {
+        if (FbTk::FbWindow::property(client,
+                                     atom_kwm1, 0l, 1l, False,
+                                     atom_kwm1, &ajunk, &ijunk, &uljunk,
+                                     &uljunk, (unsigned char **) &data) && data) {
             iskdedockapp = (data && data[0] != 0);
             XFree((void *) data);
             data = 0;
@@ -1070,6 +1071,10 @@ bool BScreen::addKdeDockapp(Window client) {
 
 FluxboxWindow *BScreen::createWindow(Window client) {
 
+    // ask for all the properties needed below at once, instead of
+    // waiting for each of them in turn
+    PropertyPrefetch prefetch(client);
+
     Fluxbox* fluxbox = Fluxbox::instance();
     fluxbox->sync(false);
 
@@ -1510,6 +1515,8 @@ void BScreen::renderPosWindow() {
 void BScreen::updateSize() {
     // update xinerama layout
     initXinerama();
+    // modes might have changed
+    m_refresh_interval = 0;
 
     // check if window geometry has changed
     if (rootWindow().updateGeometry()) {
@@ -1525,6 +1532,50 @@ void BScreen::updateSize() {
     }
 }
 
+uint64_t BScreen::refreshInterval() {
+
+    if (m_refresh_interval != 0)
+        return m_refresh_interval;
+
+    double rate = 0.0;
+
+#ifdef HAVE_RANDR
+    Display *disp = FbTk::App::instance()->display();
+    XRRScreenResources *res = XRRGetScreenResourcesCurrent(disp, rootWindow().window());
+    if (res) {
+        for (int i = 0; i < res->ncrtc; ++i) {
+            XRRCrtcInfo *crtc = XRRGetCrtcInfo(disp, res, res->crtcs[i]);
+            if (!crtc)
+                continue;
+
+            for (int m = 0; crtc->mode != None && m < res->nmode; ++m) {
+                const XRRModeInfo &mode = res->modes[m];
+                if (mode.id != crtc->mode || mode.hTotal == 0 || mode.vTotal == 0)
+                    continue;
+
+                double mode_rate = static_cast<double>(mode.dotClock) /
+                    (static_cast<double>(mode.hTotal) * mode.vTotal);
+                if (mode.modeFlags & RR_Interlace)
+                    mode_rate *= 2.0;
+                if (mode.modeFlags & RR_DoubleScan)
+                    mode_rate /= 2.0;
+                rate = std::max(rate, mode_rate);
+                break;
+            }
+            XRRFreeCrtcInfo(crtc);
+        }
+        XRRFreeScreenResources(res);
+    }
+#endif // HAVE_RANDR
+
+    // no (usable) mode info
+    if (rate < 1.0 || rate > 1000.0)
+        rate = 60.0;
+
+    m_refresh_interval = static_cast<uint64_t>(FbTk::FbTime::IN_SECONDS / rate);
+    return m_refresh_interval;
+}
+
 
 /**
  * Find the winclient to this window's left
@@ -1568,6 +1619,7 @@ void BScreen::clearXinerama() {
 
     m_xinerama.avail = false;
     m_xinerama.heads.clear();
+    updateHeadGrid();
 }
 
 void BScreen::initXinerama() {
@@ -1602,6 +1654,7 @@ void BScreen::initXinerama() {
         m_xinerama.heads[i]._height = si[i].height;
     }
     XFree(si);
+    updateHeadGrid();
 
     fbdbg<<"BScreen::initXinerama(): number of heads ="<<number<<endl;
 
@@ -1656,15 +1709,55 @@ void BScreen::clearHeads() {
     }
 }
 
-int BScreen::getHead(int x, int y) const {
-#ifdef XINERAMA
-    if (hasXinerama()) {
-        for (int i = 0; i < numHeads(); i++) {
-            if (RectangleUtil::insideBorder(m_xinerama.heads[i], x, y, 0)) {
-                return i+1;
+void BScreen::updateHeadGrid() {
+
+    vector<int> &xs = m_xinerama.grid_x;
+    vector<int> &ys = m_xinerama.grid_y;
+    xs.clear();
+    ys.clear();
+    m_xinerama.grid.clear();
+
+    for (int i = 0; i < numHeads(); ++i) {
+        const XineramaHeadInfo &hi = m_xinerama.heads[i];
+        xs.push_back(hi.x());
+        xs.push_back(hi.x() + hi.width());
+        ys.push_back(hi.y());
+        ys.push_back(hi.y() + hi.height());
+    }
+    std::sort(xs.begin(), xs.end());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+    std::sort(ys.begin(), ys.end());
+    ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+    if (xs.size() < 2 || ys.size() < 2)
+        return;
+
+    // every head covers whole cells, so one point tells about the cell.
+    // overlapping heads: the first one wins, like it did before
+    m_xinerama.grid.resize((xs.size() - 1) * (ys.size() - 1), 0);
+    for (size_t y = 0; y + 1 < ys.size(); ++y) {
+        for (size_t x = 0; x + 1 < xs.size(); ++x) {
+            for (int i = 0; i < numHeads(); ++i) {
+                if (RectangleUtil::insideBorder(m_xinerama.heads[i], xs[x], ys[y], 0)) {
+                    m_xinerama.grid[y * (xs.size() - 1) + x] = i + 1;
+                    break;
+                }
             }
         }
     }
+}
+
+int BScreen::getHead(int x, int y) const {
+#ifdef XINERAMA
+    if (hasXinerama() && !m_xinerama.grid.empty()) {
+        const vector<int> &xs = m_xinerama.grid_x;
+        const vector<int> &ys = m_xinerama.grid_y;
+        size_t cx = std::upper_bound(xs.begin(), xs.end(), x) - xs.begin();
+        size_t cy = std::upper_bound(ys.begin(), ys.end(), y) - ys.begin();
+        if (cx == 0 || cx == xs.size() || cy == 0 || cy == ys.size())
+            return 0;
+        return m_xinerama.grid[(cy - 1) * (xs.size() - 1) + cx - 1];
+    }
 #endif // XINERAMA
     return 0;
 }
@@ -1709,12 +1802,15 @@ int BScreen::getCurrHead() const {
     if (!hasXinerama()) return 0;
     int root_x = 0, root_y = 0;
 #ifdef XINERAMA
-    union { int i; unsigned int ui; Window w; } ignore;
-
-    XQueryPointer(FbTk::App::instance()->display(),
-                  rootWindow().window(), &ignore.w,
-                  &ignore.w, &root_x, &root_y,
-                  &ignore.i, &ignore.i, &ignore.ui);
+    // the event being handled knows where the pointer is
+    if (!Fluxbox::instance()->eventPointer(rootWindow().window(), root_x, root_y)) {
+        union { int i; unsigned int ui; Window w; } ignore;
+
+        XQueryPointer(FbTk::App::instance()->display(),
+                      rootWindow().window(), &ignore.w,
+                      &ignore.w, &root_x, &root_y,
+                      &ignore.i, &ignore.i, &ignore.ui);
+    }
 #endif // XINERAMA
     return getHead(root_x, root_y);
 }
@@ -1772,3 +1868,37 @@ pair<int,int> BScreen::clampToHead(int head, int x, int y, int w, int h) const {
 
     return make_pair(x,y);
 }
+
+void BScreen::queueRender(FbWinFrame &frame) {
+
+    if (!m_render_queued.insert(&frame).second)
+        return;
+
+    if (frame.focused())
+        m_render_queue.push_front(&frame);
+    else
+        m_render_queue.push_back(&frame);
+
+    if (!m_render_timer.isTiming())
+        m_render_timer.start();
+}
+
+void BScreen::unqueueRender(FbWinFrame &frame) {
+    if (m_render_queued.erase(&frame))
+        m_render_queue.remove(&frame);
+}
+
+void BScreen::renderQueue() {
+
+    const uint64_t start = FbTk::FbTime::mono();
+    while (!m_render_queue.empty() &&
+           FbTk::FbTime::mono() - start < RENDER_QUEUE_SLICE) {
+        FbWinFrame *frame = m_render_queue.front();
+        m_render_queue.pop_front();
+        m_render_queued.erase(frame);
+        frame->renderPending();
+    }
+
+    if (!m_render_queue.empty())
+        m_render_timer.start();
+}
@@ -40,6 +40,7 @@
 #include "FbTk/NotCopyable.hh"
 #include "FbTk/Signal.hh"
 #include "FbTk/RelCalcHelper.hh"
+#include "FbTk/Timer.hh"
 
 #include "FocusControl.hh"
 
@@ -49,6 +50,7 @@
 #include <fstream>
 #include <memory>
 #include <map>
+#include <set>
 
 class ClientPattern;
 class FbMenu;
@@ -63,6 +65,7 @@ class HeadArea;
 class ScreenPlacement;
 class TooltipWindow;
 class OSDWindow;
+class OutlineWindow;
 
 namespace FbTk {
 class Menu;
@@ -96,6 +99,7 @@ public:
     bool doAutoRaise() const { return *resource.auto_raise; }
     bool clickRaises() const { return *resource.click_raises; }
     bool doOpaqueMove() const { return *resource.opaque_move; }
+    bool doPacedMoveResize() const { return *resource.paced_move_resize; }
     bool doFullMax() const { return *resource.full_max; }
     bool getMaxIgnoreIncrement() const { return *resource.max_ignore_inc; }
     bool getMaxDisableMove() const { return *resource.max_disable_move; }
@@ -354,6 +358,20 @@ public:
     void hideTooltip();
 
     TooltipWindow& tooltipWindow() { return *m_tooltip_window; }
+    /// outline of a window being moved or resized in paced mode
+    OutlineWindow& outlineWindow() { return *m_outline_window; }
+
+    /// @return time between two frames of the fastest monitor, in microseconds
+    uint64_t refreshInterval();
+
+    /**
+       renders the decorations of 'frame' after the current event, in
+       small portions between the following events. used while a style
+       is applied, to render each frame once and keep fluxbox responsive.
+    */
+    void queueRender(FbWinFrame &frame);
+    /// removes 'frame' from the queue, e.g. when it is destroyed
+    void unqueueRender(FbWinFrame &frame);
 
     void setLayer(FbTk::LayerItem &item, int layernum);
     // remove? no, items are never removed from their layer until they die
@@ -372,6 +390,8 @@ public:
 
     void initXinerama();
     void clearXinerama();
+    /// rebuilds the lookup grid for getHead()
+    void updateHeadGrid();
     void clearHeads();
     /// clean up xinerama
 
@@ -448,6 +468,7 @@ private:
     void setupConfigmenu(FbTk::Menu &menu);
     void renderGeomWindow();
     void renderPosWindow();
+    void renderQueue();
     void focusedWinFrameThemeReconfigured();
 
     int getGap(int head, const char type);
@@ -497,6 +518,11 @@ private:
     std::auto_ptr<OSDWindow> m_geom_window;
     std::auto_ptr<OSDWindow> m_pos_window;
     std::auto_ptr<TooltipWindow> m_tooltip_window;
+    std::auto_ptr<OutlineWindow> m_outline_window;
+    uint64_t m_refresh_interval; ///< cached refreshInterval(), 0 if unknown
+    std::list<FbWinFrame *> m_render_queue; ///< focused frame first
+    std::set<FbWinFrame *> m_render_queued; ///< the frames in m_render_queue
+    FbTk::Timer m_render_timer;
     FbTk::FbWindow m_dummy_window;
 
     ScreenResource resource;
@@ -530,6 +556,12 @@ private:
         int center_x;
         int center_y;
         std::vector<XineramaHeadInfo> heads;
+        // the screen cut into cells along all head edges; the head of a
+        // cell is grid[y * (grid_x.size() - 1) + x], where grid_x[x] and
+        // grid_y[y] are the sorted edges left of / above the cell
+        std::vector<int> grid_x;
+        std::vector<int> grid_y;
+        std::vector<int> grid;
     } m_xinerama;
 
     std::vector<HeadArea*> m_head_areas;
@@ -31,6 +31,7 @@
 #include "Window.hh"
 
 #include "FbTk/Menu.hh"
+#include "FbTk/Stats.hh"
 
 #include <iostream>
 #include <exception>
@@ -61,6 +62,7 @@ ScreenPlacement::ScreenPlacement(BScreen &screen):
 bool ScreenPlacement::placeWindow(const FluxboxWindow &win, int head,
                                   int &place_x, int &place_y) {
 
+    FBTK_STATS_TIME("ScreenPlacement::placeWindow");
 
     // check the resource placement and see if has changed
     // and if so update the strategy
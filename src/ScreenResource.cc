@@ -83,6 +83,7 @@ ScreenResource::ScreenResource(FbTk::ResourceManager& rm,
         const std::string& scrname,
         const std::string& altscrname):
     opaque_move(rm, true, scrname + ".opaqueMove", altscrname+".OpaqueMove"),
+    paced_move_resize(rm, false, scrname+".pacedMoveResize", altscrname+".PacedMoveResize"),
     full_max(rm, false, scrname+".fullMaximization", altscrname+".FullMaximization"),
     max_ignore_inc(rm, true, scrname+".maxIgnoreIncrement", altscrname+".MaxIgnoreIncrement"),
     max_disable_move(rm, false, scrname+".maxDisableMove", altscrname+".MaxDisableMove"),
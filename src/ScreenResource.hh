@@ -32,6 +32,7 @@ struct ScreenResource {
             const std::string &scrname, const std::string &altscrname);
 
     FbTk::Resource<bool> opaque_move,
+       paced_move_resize,
        full_max,
        max_ignore_inc, 
        max_disable_move,
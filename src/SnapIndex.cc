@@ -0,0 +1,78 @@
+// SnapIndex.cc for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "SnapIndex.hh"
+
+#include <algorithm>
+
+#ifdef HAVE_CSTDLIB
+  #include <cstdlib>
+#else
+  #include <stdlib.h>
+#endif
+
+void SnapIndex::clear() {
+    m_x.clear();
+    m_y.clear();
+}
+
+void SnapIndex::add(int left, int right, int top, int bottom) {
+    Edge edge;
+
+    edge.from = top;
+    edge.to = bottom;
+    edge.pos = left;
+    m_x.push_back(edge);
+    edge.pos = right;
+    m_x.push_back(edge);
+
+    edge.from = left;
+    edge.to = right;
+    edge.pos = top;
+    m_y.push_back(edge);
+    edge.pos = bottom;
+    m_y.push_back(edge);
+}
+
+void SnapIndex::finish() {
+    std::sort(m_x.begin(), m_x.end());
+    std::sort(m_y.begin(), m_y.end());
+}
+
+void SnapIndex::snap(int &dx, int &dy, int left, int right, int top, int bottom) const {
+    snap(m_x, dx, left, top, bottom);
+    snap(m_x, dx, right, top, bottom);
+    snap(m_y, dy, top, left, right);
+    snap(m_y, dy, bottom, left, right);
+}
+
+void SnapIndex::snap(const Edges &edges, int &delta, int pos, int from, int to) {
+
+    // only edges closer than 'delta' are of interest
+    Edge first;
+    first.pos = pos - abs(delta) + 1;
+    Edges::const_iterator it = std::lower_bound(edges.begin(), edges.end(), first);
+
+    for (; it != edges.end() && it->pos < pos + abs(delta); ++it) {
+        if (abs(it->pos - pos) < abs(delta) && from <= it->to && to >= it->from)
+            delta = it->pos - pos;
+    }
+}
@@ -0,0 +1,68 @@
+// SnapIndex.hh for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef SNAPINDEX_HH
+#define SNAPINDEX_HH
+
+#include <vector>
+
+/**
+   The edges a window can snap to while it is moved, sorted by position.
+
+   Each rectangle added contributes its left and right edge, which count
+   for the vertical span of the rectangle, and its top and bottom edge,
+   which count for the horizontal span. snap() then only looks at the
+   edges within the snap distance instead of at every rectangle.
+*/
+class SnapIndex {
+public:
+    void clear();
+
+    /// adds the edges of a rectangle
+    void add(int left, int right, int top, int bottom);
+
+    /// sorts the edges; must be called after add() and before snap()
+    void finish();
+
+    /**
+       finds the nearest edges to the edges of a rectangle. For the left
+       and right edges only edges next to the rectangle count, the same
+       for top and bottom.
+       @param dx best x offset so far; replaced by a smaller one, if found
+       @param dy best y offset so far; replaced by a smaller one, if found
+    */
+    void snap(int &dx, int &dy, int left, int right, int top, int bottom) const;
+
+private:
+    struct Edge {
+        int pos;
+        int from, to; ///< span of the edge
+        bool operator < (const Edge &other) const { return pos < other.pos; }
+    };
+    typedef std::vector<Edge> Edges;
+
+    static void snap(const Edges &edges, int &delta, int pos, int from, int to);
+
+    Edges m_x; ///< left and right edges
+    Edges m_y; ///< top and bottom edges
+};
+
+#endif // SNAPINDEX_HH
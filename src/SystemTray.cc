@@ -524,8 +524,8 @@ void SystemTray::update() {
     else {
         if(m_pixmap)
             m_screen.imageControl().removeImage(m_pixmap);
-        m_pixmap = m_screen.imageControl().renderImage(width(), height(),
-                                                       m_theme->texture(), orientation());
+        m_pixmap = m_screen.imageControl().renderBackground(width(), height(),
+                                                            m_theme->texture(), orientation());
         m_window.setBackgroundPixmap(m_pixmap);
     }
 
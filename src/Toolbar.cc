@@ -462,7 +462,7 @@ void Toolbar::reconfigure() {
         if (where == RIGHTCENTER || where == RIGHTTOP || where == RIGHTBOTTOM)
             orient = FbTk::ROT90;
 
-        m_window_pm = screen().imageControl().renderImage(
+        m_window_pm = screen().imageControl().renderBackground(
                           frame.window.width(), frame.window.height(),
                           theme()->toolbar(), orient);
         frame.window.setBackgroundPixmap(m_window_pm);
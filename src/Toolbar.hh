@@ -43,6 +43,7 @@
 #include "FbTk/FbWindow.hh"
 #include "FbTk/Signal.hh"
 
+#include <list>
 #include <memory>
 
 class BScreen;
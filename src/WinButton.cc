@@ -282,14 +282,17 @@ void WinButton::updateAll() {
         Display* display = m_listen_to.fbWindow().display();
         int screen = m_listen_to.screen().screenNumber();
 
-        Drawable d = m_listen_to.icon().pixmap().drawable();
+        // ask for the size shown, so the icon needs no scaling here
+        const FbTk::PixmapWithMask &icon = m_listen_to.icon(w, h);
+
+        Drawable d = icon.pixmap().drawable();
         if (d != None) {
              m_icon_pixmap.copy(d, DefaultDepth(display, screen), screen);
              m_icon_pixmap.scale(w, h);
         } else
             m_icon_pixmap.release();
 
-        d = m_listen_to.icon().mask().drawable();
+        d = icon.mask().drawable();
         if (d != None) {
             m_icon_mask.copy(d, 0, 0);
             m_icon_mask.scale(w, h);
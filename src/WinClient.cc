@@ -27,6 +27,7 @@
 #include "Screen.hh"
 #include "FbAtoms.hh"
 #include "Xutil.hh"
+#include "NetWmIcon.hh"
 #include "Debug.hh"
 
 #include "FbTk/EventManager.hh"
@@ -212,11 +213,11 @@ bool WinClient::getAttrib(XWindowAttributes &attr) const {
 }
 
 bool WinClient::getWMName(XTextProperty &textprop) const {
-    return XGetWMName(display(), window(), &textprop);
+    return textProperty(window(), XA_WM_NAME, textprop);
 }
 
 bool WinClient::getWMIconName(XTextProperty &textprop) const {
-    return XGetWMIconName(display(), window(), &textprop);
+    return textProperty(window(), XA_WM_ICON_NAME, textprop);
 }
 
 string WinClient::getWMRole() const {
@@ -242,7 +243,7 @@ void WinClient::updateTransientInfo() {
     transient_for = 0;
     // determine if this is a transient window
     Window win = 0;
-    if (!XGetTransientForHint(display(), window(), &win)) {
+    if (!Xutil::getTransientForHint(window(), win)) {
 
         fbdbg<<__FUNCTION__<<": window() = 0x"<<hex<<window()<<dec<<"Failed to read transient for hint."<<endl;
         return;
@@ -331,6 +332,26 @@ void WinClient::setIcon(const FbTk::PixmapWithMask& pm) {
     titleSig().emit(m_title.logical(), *this);
 }
 
+void WinClient::updateNetWmIcon() {
+
+    if (m_net_wm_icon.get())
+        m_net_wm_icon->reset();
+    else
+        m_net_wm_icon.reset(new NetWmIcon(window(), screen().screenNumber()));
+
+    titleSig().emit(m_title.logical(), *this);
+}
+
+const FbTk::PixmapWithMask &WinClient::icon() const {
+    return icon(0, 0);
+}
+
+const FbTk::PixmapWithMask &WinClient::icon(unsigned int width, unsigned int height) const {
+    if (!m_icon_override && m_net_wm_icon.get() && !m_net_wm_icon->empty())
+        return m_net_wm_icon->icon(width, height);
+    return m_icon;
+}
+
 void WinClient::setFluxboxWindow(FluxboxWindow *win) {
     m_fbwin = win;
 }
@@ -361,7 +382,7 @@ void WinClient::updateMWMHints() {
 }
 
 void WinClient::updateWMHints() {
-    XWMHints *wmhint = XGetWMHints(display(), window());
+    XWMHints *wmhint = Xutil::getWMHints(window());
     accepts_input = true;
     window_group = None;
     initial_state = NormalState;
@@ -418,7 +439,7 @@ void WinClient::updateWMHints() {
 void WinClient::updateWMNormalHints() {
     long icccm_mask;
     XSizeHints sizehint;
-    if (!XGetWMNormalHints(display(), window(), &sizehint, &icccm_mask))
+    if (!Xutil::getWMNormalHints(window(), sizehint, icccm_mask))
         sizehint.flags = 0;
 
     normal_hint_flags = sizehint.flags;
@@ -548,23 +569,21 @@ void WinClient::setAttentionState(bool value) {
 }
 
 void WinClient::updateWMProtocols() {
-    Atom *proto = 0;
-    int num_return = 0;
+    std::vector<Atom> proto;
     FbAtoms *fbatoms = FbAtoms::instance();
 
-    if (XGetWMProtocols(display(), window(), &proto, &num_return)) {
+    if (Xutil::getWMProtocols(window(), proto)) {
 
         // defaults
         send_focus_message = false;
         send_close_message = false;
-        for (int i = 0; i < num_return; ++i) {
+        for (size_t i = 0; i < proto.size(); ++i) {
             if (proto[i] == fbatoms->getWMDeleteAtom())
                 send_close_message = true;
             else if (proto[i] == fbatoms->getWMTakeFocusAtom())
                 send_focus_message = true;
         }
 
-        XFree(proto);
         if (fbwindow())
             fbwindow()->updateFunctions();
 
@@ -30,6 +30,7 @@
 
 class BScreen;
 class Strut;
+class NetWmIcon;
 
 /// Holds client window info 
 class WinClient: public Focusable, public FbTk::FbWindow {
@@ -66,6 +67,11 @@ public:
 
     // override the icon with this
     void setIcon(const FbTk::PixmapWithMask& pm);
+    /// takes the icon from _NET_WM_ICON, read when it is needed
+    void updateNetWmIcon();
+
+    const FbTk::PixmapWithMask &icon() const;
+    const FbTk::PixmapWithMask &icon(unsigned int width, unsigned int height) const;
 
     // update some thints
     void updateMWMHints();
@@ -162,6 +168,7 @@ private:
     SizeHints m_size_hints;
 
     Strut *m_strut;
+    std::auto_ptr<NetWmIcon> m_net_wm_icon;
     // map transient_for X window to winclient transient 
     // (used if transient_for FbWindow was created after transient)    
     // Since a lot of transients can be created before transient_for 
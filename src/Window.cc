@@ -44,6 +44,8 @@
 #include "IconButton.hh"
 #include "ScreenPlacement.hh"
 #include "RectangleUtil.hh"
+#include "OutlineWindow.hh"
+#include "SnapIndex.hh"
 #include "Debug.hh"
 
 #include "FbTk/StringUtil.hh"
@@ -268,6 +270,63 @@ WinButton* makeButton(FluxboxWindow& win, FocusableTheme<WinButtonTheme>& btheme
     return new WinButton(win, btheme, theme, btype, parent, 0, 0, w, h);
 }
 
+// edges to snap to while a window is moved; only one is moved at a time
+SnapIndex s_snap_index;
+const FluxboxWindow *s_snap_window = 0;
+unsigned int s_snap_workspace = 0;
+
+/// collects the edges 'win' can snap to on the current workspace
+void buildSnapIndex(const FluxboxWindow &win) {
+
+    const BScreen &screen = win.screen();
+
+    s_snap_index.clear();
+    s_snap_window = &win;
+    s_snap_workspace = screen.currentWorkspaceID();
+
+    // the screen (or Xinerama head) edges.
+    // head "0" == whole screen width + height, which we skip since the
+    // sum of all the heads covers those edges, if >1 head
+    int starth = 0;
+    if (screen.numHeads() > 0)
+        starth = 1;
+
+    for (int h = starth; h <= screen.numHeads(); h++) {
+        s_snap_index.add(screen.maxLeft(h), screen.maxRight(h),
+                         screen.maxTop(h), screen.maxBottom(h));
+        s_snap_index.add(screen.getHeadX(h),
+                         screen.getHeadX(h) + screen.getHeadWidth(h),
+                         screen.getHeadY(h),
+                         screen.getHeadY(h) + screen.getHeadHeight(h));
+    }
+
+    // the window edges
+    const Workspace::Windows &wins = screen.currentWorkspace()->windowList();
+    Workspace::Windows::const_iterator it = wins.begin();
+    Workspace::Windows::const_iterator it_end = wins.end();
+    for (; it != it_end; ++it) {
+        const FluxboxWindow &other = **it;
+        if (&other == &win)
+            continue; // skip myself
+
+        int bw = other.decorationMask() & (WindowState::DECORM_BORDER|WindowState::DECORM_HANDLE) ?
+                 other.frame().window().borderWidth() : 0;
+
+        s_snap_index.add(other.x(), other.x() + other.width() + 2 * bw,
+                         other.y(), other.y() + other.height() + 2 * bw);
+
+        // also snap to the box containing the tabs (don't bother with actual
+        // tab edges, since they're dynamic
+        if (other.frame().externalTabMode())
+            s_snap_index.add(other.x() - other.xOffset(),
+                             other.x() - other.xOffset() + other.width() + 2 * bw + other.widthOffset(),
+                             other.y() - other.yOffset(),
+                             other.y() - other.yOffset() + other.height() + 2 * bw + other.heightOffset());
+    }
+
+    s_snap_index.finish();
+}
+
 }
 
 
@@ -279,6 +338,7 @@ FluxboxWindow::FluxboxWindow(WinClient &client):
     m_creation_time(0),
     moving(false), resizing(false),
     m_initialized(false),
+    m_paced(false),
     m_attaching_tab(0),
     display(FbTk::App::instance()->display()),
     m_button_grab_x(0), m_button_grab_y(0),
@@ -441,6 +501,11 @@ void FluxboxWindow::init() {
     m_timer.setCommand(raise_cmd);
     m_timer.fireOnce(true);
 
+    FbTk::RefCount<FbTk::Command<void> > motion_cmd(new FbTk::SimpleCommand<FluxboxWindow>(*this,
+                                                                                    &FluxboxWindow::pacedMotion));
+    m_motion_timer.setCommand(motion_cmd);
+    m_motion_timer.fireOnce(true);
+
     /**************************************************/
     /* Read state above here, apply state below here. */
     /**************************************************/
@@ -2388,178 +2453,212 @@ void FluxboxWindow::motionNotifyEvent(XMotionEvent &me) {
     // to activate it before doing the actual motionNotify code
     Fluxbox::instance()->keys()->doAction(me.type, me.state, m_last_pressed_button, context, &winClient(), me.time);
 
-    if (moving) {
+    if (moving || resizing) {
+
+        if (m_paced) {
+            // only the last position matters, it is applied on the next frame
+            m_motion_event = me;
+            if (!m_motion_timer.isTiming())
+                m_motion_timer.start();
+            return;
+        }
 
         XEvent e;
 
-        if (XCheckTypedEvent(display, MotionNotify, &e)) {
+        if (moving && XCheckTypedEvent(display, MotionNotify, &e)) {
             XPutBackEvent(display, &e);
             return;
         }
 
-        // Warp to next or previous workspace?, must have moved sideways some
-        int moved_x = me.x_root - m_last_resize_x;
-        // save last event point
-        m_last_resize_x = me.x_root;
-        m_last_resize_y = me.y_root;
-
-        // undraw rectangle before warping workspaces
-        if (!screen().doOpaqueMove()) {
-            int bw = static_cast<int>(frame().window().borderWidth());
-            int w = static_cast<int>(frame().width()) + 2*bw -1;
-            int h = static_cast<int>(frame().height()) + 2*bw - 1;
-            if (w > 0 && h > 0) {
-                parent().drawRectangle(screen().rootTheme()->opGC(),
-                    m_last_move_x, m_last_move_y, w, h);
-            }
-        }
+        if (moving)
+            moveMotion(me);
+        else
+            resizeMotion(me);
 
-        if (moved_x && screen().isWorkspaceWarping()) {
-            unsigned int cur_id = screen().currentWorkspaceID();
-            unsigned int new_id = cur_id;
-            const int warpPad = screen().getEdgeSnapThreshold();
-            // 1) if we're inside the border threshold
-            // 2) if we moved in the right direction
-            if (me.x_root >= int(screen().width()) - warpPad - 1 &&
-                    moved_x > 0) {
-                //warp right
-                new_id = (cur_id + 1) % screen().numberOfWorkspaces();
-                m_last_resize_x = 0; // move mouse back to x=0
-            } else if (me.x_root <= warpPad &&
-                    moved_x < 0) {
-                //warp left
-                new_id = (cur_id + screen().numberOfWorkspaces() - 1) % screen().numberOfWorkspaces();
-                m_last_resize_x = screen().width() - 1; // move mouse to screen width - 1
-            }
-            if (new_id != cur_id) {
+    } else if (m_attaching_tab != 0) {
+        //
+        // drag'n'drop code for tabs
+        //
 
-                // remove motion events from queue to avoid repeated warps
-                while (XCheckTypedEvent(display, MotionNotify, &e)) {
-                    // might as well update the y-coordinate
-                    m_last_resize_y = e.xmotion.y_root;
-                }
+        // we already grabed and started to drag'n'drop tab
+        // so we update drag'n'drop-rectangle
+        int dx = me.x_root - m_button_grab_x, dy = me.y_root - m_button_grab_y;
 
-                // move the pointer to (m_last_resize_x,m_last_resize_y)
-                XWarpPointer(display, None, me.root, 0, 0, 0, 0,
-                        m_last_resize_x, m_last_resize_y);
+        parent().drawRectangle(screen().rootTheme()->opGC(),
+                               m_last_move_x, m_last_move_y,
+                               m_last_resize_w, m_last_resize_h);
+        parent().drawRectangle(screen().rootTheme()->opGC(),
+                               dx, dy,
+                               m_last_resize_w, m_last_resize_h);
 
-                if (screen().doOpaqueMove())
-                    screen().sendToWorkspace(new_id, this, true);
-                else
-                    screen().changeWorkspaceID(new_id, false);
-            }
-        }
+        // change remembered position of rectangle
+        m_last_move_x = dx;
+        m_last_move_y = dy;
+    }
 
-        int dx = m_last_resize_x - m_button_grab_x,
-            dy = m_last_resize_y - m_button_grab_y;
+}
+
+void FluxboxWindow::moveMotion(XMotionEvent &me) {
 
-        dx -= frame().window().borderWidth();
-        dy -= frame().window().borderWidth();
+    // Warp to next or previous workspace?, must have moved sideways some
+    int moved_x = me.x_root - m_last_resize_x;
+    // save last event point
+    m_last_resize_x = me.x_root;
+    m_last_resize_y = me.y_root;
 
-        // dx = current left side, dy = current top
-        doSnapping(dx, dy);
+    // undraw rectangle before warping workspaces
+    if (!screen().doOpaqueMove()) {
+        int bw = static_cast<int>(frame().window().borderWidth());
+        int w = static_cast<int>(frame().width()) + 2*bw -1;
+        int h = static_cast<int>(frame().height()) + 2*bw - 1;
+        if (w > 0 && h > 0) {
+            eraseOutline(m_last_move_x, m_last_move_y, w, h);
+        }
+    }
 
-        // do not update display if another motion event is already pending
+    if (moved_x && screen().isWorkspaceWarping()) {
+        unsigned int cur_id = screen().currentWorkspaceID();
+        unsigned int new_id = cur_id;
+        const int warpPad = screen().getEdgeSnapThreshold();
+        // 1) if we're inside the border threshold
+        // 2) if we moved in the right direction
+        if (me.x_root >= int(screen().width()) - warpPad - 1 &&
+                moved_x > 0) {
+            //warp right
+            new_id = (cur_id + 1) % screen().numberOfWorkspaces();
+            m_last_resize_x = 0; // move mouse back to x=0
+        } else if (me.x_root <= warpPad &&
+                moved_x < 0) {
+            //warp left
+            new_id = (cur_id + screen().numberOfWorkspaces() - 1) % screen().numberOfWorkspaces();
+            m_last_resize_x = screen().width() - 1; // move mouse to screen width - 1
+        }
+        if (new_id != cur_id) {
 
-        if (!screen().doOpaqueMove()) {
-            int bw = frame().window().borderWidth();
-            int w = static_cast<int>(frame().width()) + 2*bw - 1;
-            int h = static_cast<int>(frame().height()) + 2*bw - 1;
-            if (w > 0 && h > 0) {
-                parent().drawRectangle(screen().rootTheme()->opGC(), dx, dy, w, h);
+            // remove motion events from queue to avoid repeated warps
+            XEvent e;
+            while (XCheckTypedEvent(display, MotionNotify, &e)) {
+                // might as well update the y-coordinate
+                m_last_resize_y = e.xmotion.y_root;
             }
-            m_last_move_x = dx;
-            m_last_move_y = dy;
-        } else {
-            //moveResize(dx, dy, frame().width(), frame().height());
-            // need to move the base window without interfering with transparency
-            frame().quietMoveResize(dx, dy, frame().width(), frame().height());
+
+            // move the pointer to (m_last_resize_x,m_last_resize_y)
+            XWarpPointer(display, None, me.root, 0, 0, 0, 0,
+                    m_last_resize_x, m_last_resize_y);
+
+            if (screen().doOpaqueMove())
+                screen().sendToWorkspace(new_id, this, true);
+            else
+                screen().changeWorkspaceID(new_id, false);
         }
+    }
 
-        screen().showPosition(dx, dy);
-        // end if moving
-    } else if (resizing) {
+    int dx = m_last_resize_x - m_button_grab_x,
+        dy = m_last_resize_y - m_button_grab_y;
 
-        int old_resize_x = m_last_resize_x;
-        int old_resize_y = m_last_resize_y;
-        int old_resize_w = m_last_resize_w;
-        int old_resize_h = m_last_resize_h;
+    dx -= frame().window().borderWidth();
+    dy -= frame().window().borderWidth();
 
-        int dx = me.x - m_button_grab_x;
-        int dy = me.y - m_button_grab_y;
+    // dx = current left side, dy = current top
+    doSnapping(dx, dy);
 
-        if (m_resize_corner == LEFTTOP || m_resize_corner == LEFTBOTTOM ||
-                m_resize_corner == LEFT) {
-            m_last_resize_w = frame().width() - dx;
-            m_last_resize_x = frame().x() + dx;
-        }
-        if (m_resize_corner == LEFTTOP || m_resize_corner == RIGHTTOP ||
-                m_resize_corner == TOP) {
-            m_last_resize_h = frame().height() - dy;
-            m_last_resize_y = frame().y() + dy;
-        }
-        if (m_resize_corner == LEFTBOTTOM || m_resize_corner == BOTTOM ||
-                m_resize_corner == RIGHTBOTTOM)
-            m_last_resize_h = frame().height() + dy;
-        if (m_resize_corner == RIGHTBOTTOM || m_resize_corner == RIGHTTOP ||
-                m_resize_corner == RIGHT)
-            m_last_resize_w = frame().width() + dx;
-        if (m_resize_corner == CENTER) {
-            // dx or dy must be at least 2
-            if (abs(dx) >= 2 || abs(dy) >= 2) {
-                // take max and make it even
-                int diff = 2 * (max(dx, dy) / 2);
-
-                m_last_resize_h =  frame().height() + diff;
-
-                m_last_resize_w = frame().width() + diff;
-                m_last_resize_x = frame().x() - diff/2;
-                m_last_resize_y = frame().y() - diff/2;
-            }
+    if (!screen().doOpaqueMove()) {
+        int bw = frame().window().borderWidth();
+        int w = static_cast<int>(frame().width()) + 2*bw - 1;
+        int h = static_cast<int>(frame().height()) + 2*bw - 1;
+        if (w > 0 && h > 0) {
+            drawOutline(dx, dy, w, h);
         }
+        m_last_move_x = dx;
+        m_last_move_y = dy;
+    } else {
+        //moveResize(dx, dy, frame().width(), frame().height());
+        // need to move the base window without interfering with transparency
+        frame().quietMoveResize(dx, dy, frame().width(), frame().height());
+    }
 
-        fixSize();
-        frame().displaySize(m_last_resize_w, m_last_resize_h);
+    screen().showPosition(dx, dy);
+}
 
-        if (old_resize_x != m_last_resize_x ||
-                old_resize_y != m_last_resize_y ||
-                old_resize_w != m_last_resize_w ||
-                old_resize_h != m_last_resize_h ) {
+void FluxboxWindow::resizeMotion(XMotionEvent &me) {
 
-            // draw over old rect
-            parent().drawRectangle(screen().rootTheme()->opGC(),
-                    old_resize_x, old_resize_y,
-                    old_resize_w - 1 + 2 * frame().window().borderWidth(),
-                    old_resize_h - 1 + 2 * frame().window().borderWidth());
+    int old_resize_x = m_last_resize_x;
+    int old_resize_y = m_last_resize_y;
+    int old_resize_w = m_last_resize_w;
+    int old_resize_h = m_last_resize_h;
 
-            // draw resize rectangle
-            parent().drawRectangle(screen().rootTheme()->opGC(),
-                    m_last_resize_x, m_last_resize_y,
-                    m_last_resize_w - 1 + 2 * frame().window().borderWidth(),
-                    m_last_resize_h - 1 + 2 * frame().window().borderWidth());
+    int dx = me.x - m_button_grab_x;
+    int dy = me.y - m_button_grab_y;
 
+    if (m_resize_corner == LEFTTOP || m_resize_corner == LEFTBOTTOM ||
+            m_resize_corner == LEFT) {
+        m_last_resize_w = frame().width() - dx;
+        m_last_resize_x = frame().x() + dx;
+    }
+    if (m_resize_corner == LEFTTOP || m_resize_corner == RIGHTTOP ||
+            m_resize_corner == TOP) {
+        m_last_resize_h = frame().height() - dy;
+        m_last_resize_y = frame().y() + dy;
+    }
+    if (m_resize_corner == LEFTBOTTOM || m_resize_corner == BOTTOM ||
+            m_resize_corner == RIGHTBOTTOM)
+        m_last_resize_h = frame().height() + dy;
+    if (m_resize_corner == RIGHTBOTTOM || m_resize_corner == RIGHTTOP ||
+            m_resize_corner == RIGHT)
+        m_last_resize_w = frame().width() + dx;
+    if (m_resize_corner == CENTER) {
+        // dx or dy must be at least 2
+        if (abs(dx) >= 2 || abs(dy) >= 2) {
+            // take max and make it even
+            int diff = 2 * (max(dx, dy) / 2);
+
+            m_last_resize_h =  frame().height() + diff;
+
+            m_last_resize_w = frame().width() + diff;
+            m_last_resize_x = frame().x() - diff/2;
+            m_last_resize_y = frame().y() - diff/2;
         }
-    } else if (m_attaching_tab != 0) {
-        //
-        // drag'n'drop code for tabs
-        //
+    }
 
-        // we already grabed and started to drag'n'drop tab
-        // so we update drag'n'drop-rectangle
-        int dx = me.x_root - m_button_grab_x, dy = me.y_root - m_button_grab_y;
+    fixSize();
+    frame().displaySize(m_last_resize_w, m_last_resize_h);
 
-        parent().drawRectangle(screen().rootTheme()->opGC(),
-                               m_last_move_x, m_last_move_y,
-                               m_last_resize_w, m_last_resize_h);
-        parent().drawRectangle(screen().rootTheme()->opGC(),
-                               dx, dy,
-                               m_last_resize_w, m_last_resize_h);
+    if (old_resize_x != m_last_resize_x ||
+            old_resize_y != m_last_resize_y ||
+            old_resize_w != m_last_resize_w ||
+            old_resize_h != m_last_resize_h ) {
+
+        // draw over old rect
+        eraseOutline(old_resize_x, old_resize_y,
+                old_resize_w - 1 + 2 * frame().window().borderWidth(),
+                old_resize_h - 1 + 2 * frame().window().borderWidth());
+
+        // draw resize rectangle
+        drawOutline(m_last_resize_x, m_last_resize_y,
+                m_last_resize_w - 1 + 2 * frame().window().borderWidth(),
+                m_last_resize_h - 1 + 2 * frame().window().borderWidth());
 
-        // change remembered position of rectangle
-        m_last_move_x = dx;
-        m_last_move_y = dy;
     }
+}
 
+void FluxboxWindow::pacedMotion() {
+    if (moving)
+        moveMotion(m_motion_event);
+    else if (resizing)
+        resizeMotion(m_motion_event);
+}
+
+void FluxboxWindow::drawOutline(int x, int y, int w, int h) {
+    if (m_paced)
+        screen().outlineWindow().show(x, y, w, h);
+    else
+        parent().drawRectangle(screen().rootTheme()->opGC(), x, y, w, h);
+}
+
+void FluxboxWindow::eraseOutline(int x, int y, int w, int h) {
+    // the outline window is just moved by the next drawOutline()
+    if (!m_paced)
+        parent().drawRectangle(screen().rootTheme()->opGC(), x, y, w, h);
 }
 
 void FluxboxWindow::enterNotifyEvent(XCrossingEvent &ev) {
@@ -2748,6 +2847,9 @@ void FluxboxWindow::startMoving(int x, int y) {
     m_button_grab_y = y - frame().y() - frame().window().borderWidth();
 
     moving = true;
+    m_paced = screen().doPacedMoveResize();
+    if (m_paced)
+        m_motion_timer.setTimeout(screen().refreshInterval());
 
     Fluxbox *fluxbox = Fluxbox::instance();
     // grabbing (and masking) on the root window allows us to
@@ -2763,34 +2865,50 @@ void FluxboxWindow::startMoving(int x, int y) {
 
     m_last_move_x = frame().x();
     m_last_move_y = frame().y();
+
+    if (screen().getEdgeSnapThreshold() != 0)
+        buildSnapIndex(*this);
+
     if (! screen().doOpaqueMove()) {
-        fluxbox->grab();
-        parent().drawRectangle(screen().rootTheme()->opGC(),
-                               frame().x(), frame().y(),
-                               frame().width() + 2*frame().window().borderWidth()-1,
-                               frame().height() + 2*frame().window().borderWidth()-1);
+        // the outline window needs no protection against other clients
+        if (!m_paced)
+            fluxbox->grab();
+        drawOutline(frame().x(), frame().y(),
+                    frame().width() + 2*frame().window().borderWidth()-1,
+                    frame().height() + 2*frame().window().borderWidth()-1);
         screen().showPosition(frame().x(), frame().y());
     }
 }
 
 void FluxboxWindow::stopMoving(bool interrupted) {
+    // catch up with the pointer
+    if (m_motion_timer.isTiming()) {
+        m_motion_timer.stop();
+        if (!interrupted)
+            moveMotion(m_motion_event);
+    }
+
     moving = false;
+    s_snap_index.clear();
+    s_snap_window = 0;
     Fluxbox *fluxbox = Fluxbox::instance();
 
     fluxbox->maskWindowEvents(0, 0);
 
     if (! screen().doOpaqueMove()) {
-        parent().drawRectangle(screen().rootTheme()->opGC(),
-                               m_last_move_x, m_last_move_y,
-                               frame().width() + 2*frame().window().borderWidth()-1,
-                               frame().height() + 2*frame().window().borderWidth()-1);
+        eraseOutline(m_last_move_x, m_last_move_y,
+                     frame().width() + 2*frame().window().borderWidth()-1,
+                     frame().height() + 2*frame().window().borderWidth()-1);
+        if (m_paced)
+            screen().outlineWindow().hide();
         if (!interrupted) {
             moveResize(m_last_move_x, m_last_move_y, frame().width(), frame().height());
             if (m_workspace_number != screen().currentWorkspaceID())
                 screen().sendToWorkspace(screen().currentWorkspaceID(), this);
             focus();
         }
-        fluxbox->ungrab();
+        if (!m_paced)
+            fluxbox->ungrab();
     } else if (!interrupted) {
         moveResize(frame().x(), frame().y(), frame().width(), frame().height(), true);
         frame().notifyMoved(true);
@@ -2810,39 +2928,6 @@ void FluxboxWindow::stopMoving(bool interrupted) {
     }
 }
 
-/**
- * Helper function that snaps a window to another window
- * We snap if we're closer than the x/ylimits.
- */
-inline void snapToWindow(int &xlimit, int &ylimit,
-                         int left, int right, int top, int bottom,
-                         int oleft, int oright, int otop, int obottom) {
-    // Only snap if we're adjacent to the edge we're looking at
-
-    // for left + right, need to be in the right y range
-    if (top <= obottom && bottom >= otop) {
-        // left
-        if (abs(left-oleft)  < abs(xlimit)) xlimit = -(left-oleft);
-        if (abs(right-oleft) < abs(xlimit)) xlimit = -(right-oleft);
-
-        // right
-        if (abs(left-oright)  < abs(xlimit)) xlimit = -(left-oright);
-        if (abs(right-oright) < abs(xlimit)) xlimit = -(right-oright);
-    }
-
-    // for top + bottom, need to be in the right x range
-    if (left <= oright && right >= oleft) {
-        // top
-        if (abs(top-otop)    < abs(ylimit)) ylimit = -(top-otop);
-        if (abs(bottom-otop) < abs(ylimit)) ylimit = -(bottom-otop);
-
-        // bottom
-        if (abs(top-obottom)    < abs(ylimit)) ylimit = -(top-obottom);
-        if (abs(bottom-obottom) < abs(ylimit)) ylimit = -(bottom-obottom);
-    }
-
-}
-
 /*
  * Do Whatever snapping magic is necessary, and return using the orig_left
  * and orig_top variables to indicate the new x,y position
@@ -2882,92 +2967,14 @@ void FluxboxWindow::doSnapping(int &orig_left, int &orig_top) {
         hoff = heightOffset();
     }
 
-    /////////////////////////////////////
-    // begin by checking the screen (or Xinerama head) edges
-
-    int starth = 0;
-
-    // head "0" == whole screen width + height, which we skip since the
-    // sum of all the heads covers those edges, if >1 head
-    if (screen().numHeads() > 0)
-        starth=1;
-
-    for (int h=starth; h <= screen().numHeads(); h++) {
-        snapToWindow(dx, dy, left, right, top, bottom,
-                     screen().maxLeft(h),
-                     screen().maxRight(h),
-                     screen().maxTop(h),
-                     screen().maxBottom(h));
-
-        if (i_have_tabs)
-            snapToWindow(dx, dy, left - xoff, right - xoff + woff, top - yoff, bottom - yoff + hoff,
-                         screen().maxLeft(h),
-                         screen().maxRight(h),
-                         screen().maxTop(h),
-                         screen().maxBottom(h));
-    }
-    for (int h=starth; h <= screen().numHeads(); h++) {
-        snapToWindow(dx, dy, left, right, top, bottom,
-                     screen().getHeadX(h),
-                     screen().getHeadX(h) + screen().getHeadWidth(h),
-                     screen().getHeadY(h),
-                     screen().getHeadY(h) + screen().getHeadHeight(h));
-
-        if (i_have_tabs)
-            snapToWindow(dx, dy, left - xoff, right - xoff + woff, top - yoff, bottom - yoff + hoff,
-                         screen().getHeadX(h),
-                         screen().getHeadX(h) + screen().getHeadWidth(h),
-                         screen().getHeadY(h),
-                         screen().getHeadY(h) + screen().getHeadHeight(h));
-    }
-
-    /////////////////////////////////////
-    // now check window edges
-
-    Workspace::Windows &wins =
-        screen().currentWorkspace()->windowList();
-
-    Workspace::Windows::iterator it = wins.begin();
-    Workspace::Windows::iterator it_end = wins.end();
-
-    unsigned int bw;
-    for (; it != it_end; ++it) {
-        if ((*it) == this)
-            continue; // skip myself
-
-        bw = (*it)->decorationMask() & (WindowState::DECORM_BORDER|WindowState::DECORM_HANDLE) ?
-                (*it)->frame().window().borderWidth() : 0;
-
-        snapToWindow(dx, dy, left, right, top, bottom,
-                     (*it)->x(),
-                     (*it)->x() + (*it)->width() + 2 * bw,
-                     (*it)->y(),
-                     (*it)->y() + (*it)->height() + 2 * bw);
-
-        if (i_have_tabs)
-            snapToWindow(dx, dy, left - xoff, right - xoff + woff, top - yoff, bottom - yoff + hoff,
-                         (*it)->x(),
-                         (*it)->x() + (*it)->width() + 2 * bw,
-                         (*it)->y(),
-                         (*it)->y() + (*it)->height() + 2 * bw);
-
-        // also snap to the box containing the tabs (don't bother with actual
-        // tab edges, since they're dynamic
-        if ((*it)->frame().externalTabMode())
-            snapToWindow(dx, dy, left, right, top, bottom,
-                         (*it)->x() - (*it)->xOffset(),
-                         (*it)->x() - (*it)->xOffset() + (*it)->width() + 2 * bw + (*it)->widthOffset(),
-                         (*it)->y() - (*it)->yOffset(),
-                         (*it)->y() - (*it)->yOffset() + (*it)->height() + 2 * bw + (*it)->heightOffset());
+    // the other windows don't move while we do, but we might move to
+    // another workspace
+    if (s_snap_window != this || s_snap_workspace != screen().currentWorkspaceID())
+        buildSnapIndex(*this);
 
-        if (i_have_tabs)
-            snapToWindow(dx, dy, left - xoff, right - xoff + woff, top - yoff, bottom - yoff + hoff,
-                         (*it)->x() - (*it)->xOffset(),
-                         (*it)->x() - (*it)->xOffset() + (*it)->width() + 2 * bw + (*it)->widthOffset(),
-                         (*it)->y() - (*it)->yOffset(),
-                         (*it)->y() - (*it)->yOffset() + (*it)->height() + 2 * bw + (*it)->heightOffset());
-
-    }
+    s_snap_index.snap(dx, dy, left, right, top, bottom);
+    if (i_have_tabs)
+        s_snap_index.snap(dx, dy, left - xoff, right - xoff + woff, top - yoff, bottom - yoff + hoff);
 
     // commit
     if (dx <= screen().getEdgeSnapThreshold())
@@ -3032,6 +3039,9 @@ void FluxboxWindow::startResizing(int x, int y, ReferenceCorner dir) {
     m_resize_corner = dir;
 
     resizing = true;
+    m_paced = screen().doPacedMoveResize();
+    if (m_paced)
+        m_motion_timer.setTimeout(screen().refreshInterval());
 
     disableMaximization();
 
@@ -3058,19 +3068,26 @@ void FluxboxWindow::startResizing(int x, int y, ReferenceCorner dir) {
     fixSize();
     frame().displaySize(m_last_resize_w, m_last_resize_h);
 
-    parent().drawRectangle(screen().rootTheme()->opGC(),
-                       m_last_resize_x, m_last_resize_y,
-                       m_last_resize_w - 1 + 2 * frame().window().borderWidth(),
-                       m_last_resize_h - 1 + 2 * frame().window().borderWidth());
+    drawOutline(m_last_resize_x, m_last_resize_y,
+                m_last_resize_w - 1 + 2 * frame().window().borderWidth(),
+                m_last_resize_h - 1 + 2 * frame().window().borderWidth());
 }
 
 void FluxboxWindow::stopResizing(bool interrupted) {
+    // catch up with the pointer
+    if (m_motion_timer.isTiming()) {
+        m_motion_timer.stop();
+        if (!interrupted)
+            resizeMotion(m_motion_event);
+    }
+
     resizing = false;
 
-    parent().drawRectangle(screen().rootTheme()->opGC(),
-                           m_last_resize_x, m_last_resize_y,
-                           m_last_resize_w - 1 + 2 * frame().window().borderWidth(),
-                           m_last_resize_h - 1 + 2 * frame().window().borderWidth());
+    eraseOutline(m_last_resize_x, m_last_resize_y,
+                 m_last_resize_w - 1 + 2 * frame().window().borderWidth(),
+                 m_last_resize_h - 1 + 2 * frame().window().borderWidth());
+    if (m_paced)
+        screen().outlineWindow().hide();
 
     screen().hideGeometry();
 
@@ -3293,6 +3310,10 @@ const FbTk::PixmapWithMask &FluxboxWindow::icon() const {
     return (m_client ? m_client->icon() : m_icon);
 }
 
+const FbTk::PixmapWithMask &FluxboxWindow::icon(unsigned int width, unsigned int height) const {
+    return (m_client ? m_client->icon(width, height) : m_icon);
+}
+
 const FbMenu &FluxboxWindow::menu() const {
     return screen().windowMenu();
 }
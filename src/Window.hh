@@ -38,6 +38,7 @@
 #include "FbTk/LayerItem.hh"
 #include "FbTk/Signal.hh"
 
+#include <list>
 #include <vector>
 #include <string>
 #include <memory>
@@ -416,6 +417,7 @@ public:
     bool acceptsFocus() const;
     bool isModal() const;
     const FbTk::PixmapWithMask &icon() const;
+    const FbTk::PixmapWithMask &icon(unsigned int width, unsigned int height) const;
     const FbTk::BiDiString &title() const;
     const FbTk::FbString &getWMClassName() const;
     const FbTk::FbString &getWMClassClass() const;
@@ -503,6 +505,16 @@ private:
 
     // modifies left and top if snap is necessary
     void doSnapping(int &left, int &top);
+    /// moves the frame (or its outline) to follow the pointer
+    void moveMotion(XMotionEvent &me);
+    /// resizes the outline to follow the pointer
+    void resizeMotion(XMotionEvent &me);
+    /// applies the last motion event while moving/resizing paced
+    void pacedMotion();
+    /// shows the move/resize outline, w and h as for drawRectangle()
+    void drawOutline(int x, int y, int w, int h);
+    /// removes the outline drawn by drawOutline(x, y, w, h)
+    void eraseOutline(int x, int y, int w, int h);
     // user_w/h return the values that should be shown to the user
     void fixSize();
     void moveResizeClient(WinClient &client);
@@ -532,9 +544,12 @@ private:
     uint64_t m_creation_time;
     uint64_t m_last_keypress_time;
     FbTk::Timer m_timer;
+    FbTk::Timer m_motion_timer; ///< one motion per frame while paced
+    XMotionEvent m_motion_event; ///< last motion, applied by m_motion_timer
 
     // Window states
     bool moving, resizing, m_initialized;
+    bool m_paced; ///< current move/resize is paced to the refresh rate
 
     WinClient *m_attaching_tab;
 
@@ -134,8 +134,8 @@ void WorkspaceNameTool::reRender() {
         m_screen.imageControl().removeImage(m_pixmap);
 
     if (m_theme->texture().usePixmap()) {
-        m_pixmap = m_screen.imageControl().renderImage(width(), height(),
-                                                       m_theme->texture(), orientation());
+        m_pixmap = m_screen.imageControl().renderBackground(width(), height(),
+                                                            m_theme->texture(), orientation());
         m_button.setBackgroundPixmap(m_pixmap);
     } else {
         m_pixmap = 0;
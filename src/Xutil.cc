@@ -25,6 +25,7 @@
 
 #include "FbTk/I18n.hh"
 #include "FbTk/App.hh"
+#include "FbTk/FbWindow.hh"
 
 #include <X11/Xutil.h>
 #include <X11/Xatom.h>
@@ -57,7 +58,7 @@ FbTk::FbString getWMName(Window window) {
     _FB_USES_NLS;
     FbTk::FbString name;
 
-    if (XGetWMName(display, window, &text_prop)) {
+    if (FbTk::FbWindow::textProperty(window, XA_WM_NAME, text_prop)) {
         if (text_prop.value && text_prop.nitems > 0) {
             if (text_prop.encoding != XA_STRING) {
 
@@ -89,24 +90,63 @@ FbTk::FbString getWMName(Window window) {
 }
 
 
-// The name of this particular instance
-FbTk::FbString getWMClassName(Window win) {
+namespace {
 
-    XClassHint ch;
-    FbTk::FbString instance_name;
+/// reads WM_CLASS, same as XGetClassHint()
+bool getClassHint(Window win, FbTk::FbString &name, FbTk::FbString &class_name) {
+    Atom type;
+    int format;
+    unsigned long nitems, bytes_after;
+    unsigned char *data = 0;
 
-    if (XGetClassHint(FbTk::App::instance()->display(), win, &ch) == 0) {
-        fbdbg<<"Xutil: Failed to read class hint!"<<endl;
-    } else {
+    if (!FbTk::FbWindow::property(win, XA_WM_CLASS, 0, 2048L, False, XA_STRING,
+                                  &type, &format, &nitems, &bytes_after, &data))
+        return false;
 
-        XFree(ch.res_class);
+    bool ok = false;
+    if (type == XA_STRING && format == 8 && data != 0) {
+        // "name\0class\0"
+        const char *str = reinterpret_cast<const char *>(data);
+        size_t len = strlen(str);
+        name = str;
+        class_name = len < nitems ? str + len + 1 : "";
+        ok = true;
+    }
+    if (data)
+        XFree(data);
+    return ok;
+}
 
-        if (ch.res_name != 0) {
-            instance_name = const_cast<char *>(ch.res_name);
-            XFree(ch.res_name);
-            ch.res_name = 0;
-        }
+/// reads a property of 32 bit values, at most 'max' of them
+bool getLongs(Window win, Atom prop, Atom req_type, long max, std::vector<long> &values) {
+    Atom type;
+    int format;
+    unsigned long nitems, bytes_after;
+    unsigned char *data = 0;
+
+    if (!FbTk::FbWindow::property(win, prop, 0, max, False, req_type,
+                                  &type, &format, &nitems, &bytes_after, &data))
+        return false;
+
+    bool ok = type == req_type && format == 32;
+    if (ok && data != 0) {
+        const long *longs = reinterpret_cast<const long *>(data);
+        values.assign(longs, longs + nitems);
     }
+    if (data)
+        XFree(data);
+    return ok;
+}
+
+} // end anonymous namespace
+
+// The name of this particular instance
+FbTk::FbString getWMClassName(Window win) {
+
+    FbTk::FbString instance_name, class_name;
+
+    if (!getClassHint(win, instance_name, class_name))
+        fbdbg<<"Xutil: Failed to read class hint!"<<endl;
 
     return instance_name;
 }
@@ -114,23 +154,104 @@ FbTk::FbString getWMClassName(Window win) {
 // the name of the general class of the app
 FbTk::FbString getWMClassClass(Window win) {
 
-    XClassHint ch;
-    FbTk::FbString class_name;
+    FbTk::FbString instance_name, class_name;
 
-    if (XGetClassHint(FbTk::App::instance()->display(), win, &ch) == 0) {
+    if (!getClassHint(win, instance_name, class_name))
         fbdbg<<"Xutil: Failed to read class hint!"<<endl;
-    } else {
 
-        XFree(ch.res_name);
+    return class_name;
+}
 
-        if (ch.res_class != 0) {
-            class_name = const_cast<char *>(ch.res_class);
-            XFree(ch.res_class);
-            ch.res_class = 0;
-        }
+XWMHints *getWMHints(Window win) {
+
+    // the fields of WM_HINTS, see ICCCM 4.1.2.4
+    enum { FLAGS, INPUT, INITIAL_STATE, ICON_PIXMAP, ICON_WINDOW,
+           ICON_X, ICON_Y, ICON_MASK, WINDOW_GROUP, NUM_ELEMENTS };
+
+    std::vector<long> prop;
+    if (!getLongs(win, XA_WM_HINTS, XA_WM_HINTS, NUM_ELEMENTS, prop))
+        return 0;
+
+    XWMHints *hints = 0;
+    // old clients don't set the window group
+    if (prop.size() >= NUM_ELEMENTS - 1 && (hints = XAllocWMHints()) != 0) {
+        hints->flags = prop[FLAGS];
+        hints->input = prop[INPUT] ? True : False;
+        hints->initial_state = static_cast<int>(prop[INITIAL_STATE]);
+        hints->icon_pixmap = prop[ICON_PIXMAP];
+        hints->icon_window = prop[ICON_WINDOW];
+        hints->icon_x = static_cast<int>(prop[ICON_X]);
+        hints->icon_y = static_cast<int>(prop[ICON_Y]);
+        hints->icon_mask = prop[ICON_MASK];
+        hints->window_group = prop.size() >= NUM_ELEMENTS ? prop[WINDOW_GROUP] : 0;
     }
 
-    return class_name;
+    return hints;
+}
+
+bool getWMNormalHints(Window win, XSizeHints &hints, long &supplied) {
+
+    // the fields of WM_NORMAL_HINTS, see ICCCM 4.1.2.3. clients
+    // before ICCCM 1 don't set the last three
+    enum { FLAGS, X, Y, WIDTH, HEIGHT, MIN_WIDTH, MIN_HEIGHT,
+           MAX_WIDTH, MAX_HEIGHT, WIDTH_INC, HEIGHT_INC,
+           MIN_ASPECT_X, MIN_ASPECT_Y, MAX_ASPECT_X, MAX_ASPECT_Y,
+           OLD_NUM_ELEMENTS,
+           BASE_WIDTH = OLD_NUM_ELEMENTS, BASE_HEIGHT, WIN_GRAVITY,
+           NUM_ELEMENTS };
+
+    std::vector<long> prop;
+    if (!getLongs(win, XA_WM_NORMAL_HINTS, XA_WM_SIZE_HINTS, NUM_ELEMENTS, prop) ||
+        prop.size() < OLD_NUM_ELEMENTS)
+        return false;
+
+    hints.flags = prop[FLAGS];
+    hints.x = prop[X];
+    hints.y = prop[Y];
+    hints.width = prop[WIDTH];
+    hints.height = prop[HEIGHT];
+    hints.min_width = prop[MIN_WIDTH];
+    hints.min_height = prop[MIN_HEIGHT];
+    hints.max_width = prop[MAX_WIDTH];
+    hints.max_height = prop[MAX_HEIGHT];
+    hints.width_inc = prop[WIDTH_INC];
+    hints.height_inc = prop[HEIGHT_INC];
+    hints.min_aspect.x = prop[MIN_ASPECT_X];
+    hints.min_aspect.y = prop[MIN_ASPECT_Y];
+    hints.max_aspect.x = prop[MAX_ASPECT_X];
+    hints.max_aspect.y = prop[MAX_ASPECT_Y];
+
+    supplied = USPosition | USSize | PAllHints;
+    if (prop.size() >= NUM_ELEMENTS) {
+        supplied |= PBaseSize | PWinGravity;
+        hints.base_width = prop[BASE_WIDTH];
+        hints.base_height = prop[BASE_HEIGHT];
+        hints.win_gravity = prop[WIN_GRAVITY];
+    }
+    hints.flags &= supplied;
+
+    return true;
+}
+
+bool getWMProtocols(Window win, std::vector<Atom> &protocols) {
+
+    static Atom wm_protocols = XInternAtom(FbTk::App::instance()->display(),
+                                           "WM_PROTOCOLS", False);
+
+    std::vector<long> prop;
+    if (!getLongs(win, wm_protocols, XA_ATOM, 1000000L, prop))
+        return false;
+
+    protocols.assign(prop.begin(), prop.end());
+    return true;
+}
+
+bool getTransientForHint(Window win, Window &transient_for) {
+
+    std::vector<long> prop;
+    bool ok = getLongs(win, XA_WM_TRANSIENT_FOR, XA_WINDOW, 1, prop) && !prop.empty();
+    transient_for = ok ? prop[0] : None;
+    return ok;
 }
 
 } // end namespace Xutil
@@ -24,8 +24,14 @@
 #define XUTIL_HH
 
 #include <X11/Xlib.h>
+#include <X11/Xutil.h>
 #include "FbTk/FbString.hh"
 
+#include <vector>
+
+// The ICCCM properties are read through FbTk::FbWindow::property() instead
+// of the Xlib convenience functions, so they can be answered from data
+// fetched in advance (see PropertyPrefetch).
 namespace Xutil {
 
 FbTk::FbString getWMName(Window window);
@@ -33,6 +39,15 @@ FbTk::FbString getWMName(Window window);
 FbTk::FbString getWMClassName(Window win);
 FbTk::FbString getWMClassClass(Window win);
 
+/// same as XGetWMHints(), free the result with XFree()
+XWMHints *getWMHints(Window win);
+/// same as XGetWMNormalHints()
+bool getWMNormalHints(Window win, XSizeHints &hints, long &supplied);
+/// same as XGetWMProtocols()
+bool getWMProtocols(Window win, std::vector<Atom> &protocols);
+/// same as XGetTransientForHint()
+bool getTransientForHint(Window win, Window &transient_for);
+
 
 } // end namespace Xutil
 
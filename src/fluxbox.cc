@@ -34,6 +34,8 @@
 #include "FbAtoms.hh"
 #include "FocusControl.hh"
 #include "Layer.hh"
+#include "Launcher.hh"
+#include "IPCServer.hh"
 
 #include "defaults.hh"
 #include "Debug.hh"
@@ -56,6 +58,7 @@
 #include "FbTk/Compose.hh"
 #include "FbTk/KeyUtil.hh"
 #include "FbTk/MemFun.hh"
+#include "FbTk/Stats.hh"
 
 #ifdef USE_EWMH
 #include "Ewmh.hh"
@@ -187,6 +190,70 @@ KeyReloadHelper s_key_reloader;
 typedef FbTk::SimpleCommand<KeyReloadHelper> KeyReloadHelperCmd;
 typedef FbTk::SimpleCommand<Fluxbox> FluxboxCmd;
 
+#ifdef USE_STATS
+
+const char *eventName(int type) {
+    static const char *names[] = {
+        "Error", "Reply", "KeyPress", "KeyRelease", "ButtonPress",
+        "ButtonRelease", "MotionNotify", "EnterNotify", "LeaveNotify",
+        "FocusIn", "FocusOut", "KeymapNotify", "Expose", "GraphicsExpose",
+        "NoExpose", "VisibilityNotify", "CreateNotify", "DestroyNotify",
+        "UnmapNotify", "MapNotify", "MapRequest", "ReparentNotify",
+        "ConfigureNotify", "ConfigureRequest", "GravityNotify",
+        "ResizeRequest", "CirculateNotify", "CirculateRequest",
+        "PropertyNotify", "SelectionClear", "SelectionRequest",
+        "SelectionNotify", "ColormapNotify", "ClientMessage",
+        "MappingNotify", "GenericEvent"
+    };
+    if (type >= 0 && type < int(sizeof(names) / sizeof(names[0])))
+        return names[type];
+    return "extension";
+}
+
+/// times the handling of an event and counts the X requests it made
+class EventStats: private FbTk::NotCopyable {
+public:
+    EventStats(Display *display, int type):
+        m_display(display),
+        m_requests(NextRequest(display)),
+        m_stopwatch(histogram(type)),
+        m_type(type) { }
+
+    ~EventStats() {
+        requests(m_type).add(NextRequest(m_display) - m_requests);
+    }
+
+private:
+    enum { TYPES = LASTEvent + 1 }; ///< the last one is for all extension events
+
+    static int index(int type) {
+        return type >= 0 && type < LASTEvent ? type : LASTEvent;
+    }
+
+    static FbTk::Stats::Histogram &histogram(int type) {
+        static FbTk::Stats::Histogram *histograms[TYPES];
+        FbTk::Stats::Histogram *&h = histograms[index(type)];
+        if (h == 0)
+            h = &FbTk::Stats::histogram(string("event ") + eventName(type));
+        return *h;
+    }
+
+    static FbTk::Stats::Counter &requests(int type) {
+        static FbTk::Stats::Counter *counters[TYPES];
+        FbTk::Stats::Counter *&c = counters[index(type)];
+        if (c == 0)
+            c = &FbTk::Stats::counter(string("event ") + eventName(type) + " X requests");
+        return *c;
+    }
+
+    Display *m_display;
+    unsigned long m_requests;
+    FbTk::Stats::Stopwatch m_stopwatch;
+    int m_type;
+};
+
+#endif // USE_STATS
+
 
 
 /* functor to call a memberfunction with by a reference argument
@@ -251,6 +318,7 @@ Fluxbox::Config::Config(FbTk::ResourceManager& rm, const std::string& path) :
     key_file(rm, path + "/keys", "session.keyFile", "Session.KeyFile"),
     slit_file(rm, path + "/slitlist", "session.slitlistFile", "Session.SlitlistFile"),
     apps_file(rm, path + "/apps", "session.appsFile", "Session.AppsFile"),
+    ipc_socket(rm, "", "session.ipcSocket", "Session.IPCSocket"),
     tabs_attach_area(rm, ATTACH_AREA_WINDOW, "session.tabsAttachArea", "Session.TabsAttachArea"),
     menusearch(rm, FbTk::MenuSearch::DEFAULT, "session.menuSearch", "Session.MenuSearch"),
     cache_life(rm, 5, "session.cacheLife", "Session.CacheLife"),
@@ -292,6 +360,7 @@ Fluxbox::Fluxbox(int argc, char **argv,
     m_config.file = rc_filename;
     m_active_screen.mouse = 0;
     m_active_screen.key = 0;
+    m_event_pointer.valid = false;
 
     Display *disp = FbTk::App::instance()->display();
 
@@ -355,6 +424,7 @@ Fluxbox::Fluxbox(int argc, char **argv,
 
 
     // setup theme manager to have our style file ready to be scanned
+    FbTk::ThemeManager::instance().setCacheFile(getDefaultDataFilename("stylecache"));
     FbTk::ThemeManager::instance().load(getStyleFilename(), getStyleOverlayFilename());
 
     // Create keybindings handler and load keys file
@@ -442,6 +512,9 @@ Fluxbox::Fluxbox(int argc, char **argv,
 #ifdef REMEMBER
     addAtomHandler(new Remember()); // for remembering window attribs
 #endif // REMEMBER
+#ifdef HAVE_SYS_UN_H
+    addAtomHandler(new IPCServer()); // commands and events over a socket
+#endif // HAVE_SYS_UN_H
 
     // init all "screens"
     STLUtil::forAll(m_screens, bind1st(mem_fun(&Fluxbox::initScreen), this));
@@ -523,8 +596,13 @@ void Fluxbox::eventLoop() {
 
     Display *disp = display();
 
+    Launcher::init();
+
     while (!m_state.shutdown) {
 
+        // SIGCHLD only wakes up the wait below, children are reaped here
+        Launcher::reap();
+
         if (XPending(disp)) {
             XEvent e;
             XNextEvent(disp, &e);
@@ -538,6 +616,7 @@ void Fluxbox::eventLoop() {
             } else {
                 last_bad_window = None;
                 handleEvent(&e);
+                m_event_pointer.valid = false;
             }
         } else {
             FbTk::Timer::updateTimers(ConnectionNumber(disp));
@@ -545,6 +624,21 @@ void Fluxbox::eventLoop() {
     }
 }
 
+void Fluxbox::setEventPointer(Window root, int x, int y, bool same_screen) {
+    m_event_pointer.valid = same_screen;
+    m_event_pointer.root = root;
+    m_event_pointer.x = x;
+    m_event_pointer.y = y;
+}
+
+bool Fluxbox::eventPointer(Window root, int &x, int &y) const {
+    if (!m_event_pointer.valid || m_event_pointer.root != root)
+        return false;
+    x = m_event_pointer.x;
+    y = m_event_pointer.y;
+    return true;
+}
+
 bool Fluxbox::validateWindow(Window window) const {
     XEvent event;
     if (XCheckTypedWindowEvent(display(), window, DestroyNotify, &event)) {
@@ -571,6 +665,9 @@ void Fluxbox::ungrab() {
 void Fluxbox::handleEvent(XEvent * const e) {
 
     _FB_USES_NLS;
+#ifdef USE_STATS
+    EventStats stats(display(), e->type);
+#endif // USE_STATS
     m_last_event = *e;
 
 
@@ -579,6 +676,8 @@ void Fluxbox::handleEvent(XEvent * const e) {
     if ((m_masked == e->xany.window) && m_masked_window) {
         if (e->type == MotionNotify) {
             m_last_time = e->xmotion.time;
+            setEventPointer(e->xmotion.root, e->xmotion.x_root, e->xmotion.y_root,
+                            e->xmotion.same_screen);
             m_masked_window->motionNotifyEvent(e->xmotion);
             return;
         } else if (e->type == ButtonRelease) {
@@ -587,22 +686,33 @@ void Fluxbox::handleEvent(XEvent * const e) {
 
     }
 
+    m_event_pointer.valid = false;
+
     // update key/mouse screen and last time before we enter other eventhandlers
     if (e->type == KeyPress ||
         e->type == KeyRelease) {
         m_active_screen.key = searchScreen(e->xkey.root);
+        setEventPointer(e->xkey.root, e->xkey.x_root, e->xkey.y_root,
+                        e->xkey.same_screen);
     } else if (e->type == ButtonPress ||
                e->type == ButtonRelease ||
                e->type == MotionNotify ) {
         m_last_time = e->xbutton.time;
-        if (e->type == MotionNotify)
+        if (e->type == MotionNotify) {
             m_last_time = e->xmotion.time;
+            setEventPointer(e->xmotion.root, e->xmotion.x_root, e->xmotion.y_root,
+                            e->xmotion.same_screen);
+        } else
+            setEventPointer(e->xbutton.root, e->xbutton.x_root, e->xbutton.y_root,
+                            e->xbutton.same_screen);
 
         m_active_screen.mouse = searchScreen(e->xbutton.root);
     } else if (e->type == EnterNotify ||
                e->type == LeaveNotify) {
         m_last_time = e->xcrossing.time;
         m_active_screen.mouse = searchScreen(e->xcrossing.root);
+        setEventPointer(e->xcrossing.root, e->xcrossing.x_root, e->xcrossing.y_root,
+                        e->xcrossing.same_screen);
     } else if (e->type == PropertyNotify) {
         m_last_time = e->xproperty.time;
         // check transparency atoms if it's a root pm
@@ -49,6 +49,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 #include <cstdio>
@@ -126,6 +127,7 @@ public:
     const std::string &getSlitlistFilename() const     { return *m_config.slit_file; }
     const std::string &getAppsFilename() const         { return *m_config.apps_file; }
     const std::string &getKeysFilename() const         { return *m_config.key_file; }
+    const std::string &getIPCSocketFilename() const    { return *m_config.ipc_socket; }
     int colorsPerChannel() const                       { return *m_config.colors_per_channel; }
     int getTabsPadding() const                         { return *m_config.tabs_padding; }
     unsigned int getDoubleClickInterval() const        { return *m_config.double_click_interval; }
@@ -182,11 +184,18 @@ public:
     BScreen *mouseScreen() { return m_active_screen.mouse; }
     BScreen *keyScreen() { return m_active_screen.key; }
     const XEvent &lastEvent() const { return m_last_event; }
+    /**
+       gives the pointer position of the event being handled
+       @param root the root window the position should be relative to
+       @return false if there is no such event or it has no position
+    */
+    bool eventPointer(Window root, int &x, int &y) const;
 
     AttentionNoticeHandler &attentionHandler() { return m_attention_handler; }
 
 private:
     std::string getRcFilename();
+    void setEventPointer(Window root, int x, int y, bool same_screen);
     void load_rc();
     void real_reconfigure();
     void handleEvent(XEvent *xe);
@@ -250,6 +259,7 @@ private:
         FbTk::Resource<std::string> key_file;
         FbTk::Resource<std::string> slit_file;
         FbTk::Resource<std::string> apps_file;
+        FbTk::Resource<std::string> ipc_socket;
 
         FbTk::Resource<TabsAttachArea> tabs_attach_area;
         FbTk::Resource<FbTk::MenuSearch::Mode> menusearch;
@@ -286,6 +296,13 @@ private:
         BScreen* key;
     } m_active_screen;
 
+    /// pointer position of the event being handled
+    struct {
+        bool valid;
+        Window root;
+        int x, y;
+    } m_event_pointer;
+
     Atom m_fluxbox_pid;
 
     bool m_reconfigure_wait;
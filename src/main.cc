@@ -24,6 +24,7 @@
 #include "version.h"
 #include "defaults.hh"
 #include "cli.hh"
+#include "Launcher.hh"
 
 #include "FbTk/I18n.hh"
 #include "FbTk/StringUtil.hh"
@@ -78,8 +79,8 @@ void handleSignal(int signum) {
     switch (signum) {
 #ifndef _WIN32
     case SIGCHLD: // we don't want the child process to kill us
-        // more than one process may have terminated
-        while (waitpid(-1, 0, WNOHANG | WUNTRACED) > 0);
+        // reaped by the main loop
+        Launcher::childExited();
         break;
     case SIGHUP:
         // xinit sends HUP when it wants to go down. there is no point in
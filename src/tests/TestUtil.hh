@@ -0,0 +1,51 @@
+// TestUtil.hh
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef TESTUTIL_HH
+#define TESTUTIL_HH
+
+#include <cstdio>
+#include <cstdlib>
+
+/// bookkeeping for the tests which check their results themselves
+namespace TestUtil {
+
+inline int &failures() {
+    static int failed = 0;
+    return failed;
+}
+
+/// prints the result of the check 'what'
+inline bool check(const char *what, bool ok) {
+    printf("%-48s %s\n", what, ok ? "ok" : "FAILED");
+    if (!ok)
+        failures()++;
+    return ok;
+}
+
+/// @return the exit status of the test
+inline int result() {
+    return failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // end namespace TestUtil
+
+#endif // TESTUTIL_HH
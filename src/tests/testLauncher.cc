@@ -0,0 +1,89 @@
+// testLauncher.cc
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "Launcher.hh"
+#include "fluxbox.hh"
+#include "TestUtil.hh"
+
+#include <string>
+
+// Launcher only needs it for startup ids
+Fluxbox *Fluxbox::instance() {
+    return 0;
+}
+
+namespace {
+
+void checkShell(const char *command, bool expected) {
+    std::string what = std::string("'") + command + "'" +
+        (expected ? " needs a shell" : " runs directly");
+    TestUtil::check(what.c_str(), Launcher::needsShell(command) == expected);
+}
+
+} // end anonymous namespace
+
+void testNeedsShell() {
+    // plain programs
+    checkShell("xterm", false);
+    checkShell("  xterm -e top", false);
+    checkShell("/usr/bin/firefox --new-window", false);
+    checkShell("fbsetbg -l", false);
+    checkShell("", false);
+
+    // shell syntax
+    checkShell("xterm -e 'top -d 1'", true);
+    checkShell("xterm -e \"top\"", true);
+    checkShell("xterm &", true);
+    checkShell("sleep 1; xterm", true);
+    checkShell("ls | xmessage -file -", true);
+    checkShell("xterm > /dev/null", true);
+    checkShell("xmessage $HOME", true);
+    checkShell("xmessage `date`", true);
+    checkShell("feh ~/background.png", true);
+    checkShell("feh *.png", true);
+    checkShell("(xterm)", true);
+    checkShell("LANG=C xterm", true);
+
+    // builtins and reserved words
+    checkShell("cd /tmp", true);
+    checkShell("exec xterm", true);
+    checkShell("command -v xterm", true);
+    checkShell("trap '' HUP", true);
+    checkShell("wait", true);
+    checkShell("exit", true);
+    checkShell("alias x=xterm", true);
+    checkShell("read line", true);
+    checkShell("shift", true);
+    checkShell("if true", true);
+    checkShell("  while true", true);
+    checkShell(". ~/.profile", true);
+
+    // just starting like one
+    checkShell("cdrecord -scanbus", false);
+    checkShell("waitress", false);
+}
+
+int main(int argc, char **argv) {
+
+    testNeedsShell();
+
+    return TestUtil::result();
+}
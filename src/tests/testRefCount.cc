@@ -0,0 +1,145 @@
+// testRefCount.cc
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "FbTk/RefCount.hh"
+#include "FbTk/Command.hh"
+#include "TestUtil.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <new>
+
+namespace {
+
+size_t s_allocs = 0;
+
+void check(const char *what, size_t got, size_t expected) {
+    printf("%4lu allocations, expected %4lu\n",
+           (unsigned long)got, (unsigned long)expected);
+    TestUtil::check(what, got == expected);
+}
+
+int s_alive = 0;
+
+class TestCmd: public FbTk::Command<void> {
+public:
+    TestCmd() { s_alive++; }
+    ~TestCmd() { s_alive--; }
+    void execute() { }
+};
+
+// looks like Keys::t_key
+class Node: public FbTk::RefCounted {
+public:
+    Node() { s_alive++; }
+    ~Node() { s_alive--; }
+    FbTk::RefCount<FbTk::Command<void> > command;
+    std::list<FbTk::RefCount<Node> > children;
+};
+
+} // end anonymous namespace
+
+#if __cplusplus >= 201103L
+void *operator new(size_t size) {
+#else
+void *operator new(size_t size) throw (std::bad_alloc) {
+#endif
+    s_allocs++;
+    void *p = malloc(size ? size : 1);
+    if (p == 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+#if __cplusplus >= 201103L
+void operator delete(void *p) noexcept {
+#else
+void operator delete(void *p) throw () {
+#endif
+    free(p);
+}
+
+void testEmpty() {
+    size_t start = s_allocs;
+    {
+        FbTk::RefCount<TestCmd> a;
+        FbTk::RefCount<TestCmd> b(a);
+        FbTk::RefCount<FbTk::Command<void> > c(a);
+        b = a;
+        b.reset(0);
+    }
+    check("empty handles", s_allocs - start, 0);
+}
+
+void testIntrusive() {
+    size_t start = s_allocs;
+    {
+        FbTk::RefCount<TestCmd> a(new TestCmd);
+        FbTk::RefCount<TestCmd> b(a);
+        FbTk::RefCount<FbTk::Slot<void> > c(a);
+        b = a;
+        a = a;
+        a.reset(0);
+        b.reset(0);
+        TestUtil::check("object not deleted too early", s_alive == 1);
+    }
+    check("slot with copies", s_allocs - start, 1);
+    TestUtil::check("object deleted", s_alive == 0);
+}
+
+void testPlain() {
+    size_t start = s_allocs;
+    {
+        FbTk::RefCount<int> a(new int(1));
+        FbTk::RefCount<int> b(a);
+        b = a;
+    }
+    check("plain type with copies", s_allocs - start, 2);
+}
+
+// builds a tree like a keys file with 'n' bindings
+void testKeys(size_t n) {
+    size_t start = s_allocs;
+    {
+        FbTk::RefCount<Node> root(new Node);
+        for (size_t i = 0; i < n; ++i) {
+            FbTk::RefCount<Node> key(new Node);
+            key->command.reset(new TestCmd);
+            root->children.push_back(key);
+        }
+    }
+    // per binding: the node, its list entry and its command
+    char what[64];
+    sprintf(what, "keys tree with %lu bindings", (unsigned long)n);
+    check(what, s_allocs - start, 1 + 3 * n);
+    TestUtil::check("tree deleted", s_alive == 0);
+}
+
+int main(int argc, char **argv) {
+
+    testEmpty();
+    testIntrusive();
+    testPlain();
+    testKeys(1000);
+
+    return TestUtil::result();
+}
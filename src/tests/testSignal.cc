@@ -0,0 +1,201 @@
+// testSignal.cc
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "FbTk/Signal.hh"
+#include "TestUtil.hh"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/time.h>
+
+using TestUtil::check;
+
+namespace {
+
+struct Append {
+    Append(std::string &str, char c): str(str), c(c) { }
+    void operator()(int) { str += c; }
+    std::string &str;
+    char c;
+};
+
+struct Count {
+    explicit Count(unsigned long &n): n(n) { }
+    void operator()(int i) { n += i; }
+    unsigned long &n;
+};
+
+int s_alive = 0;
+
+// counts its living copies
+struct Alive {
+    Alive() { s_alive++; }
+    Alive(const Alive &) { s_alive++; }
+    ~Alive() { s_alive--; }
+    void operator()(int) { }
+};
+
+typedef FbTk::Signal<int> IntSignal;
+
+// disconnects a slot of 'sig' when called
+struct Disconnect {
+    Disconnect(IntSignal &sig, IntSignal::SlotID &id): sig(sig), id(id) { }
+    void operator()(int) { sig.disconnect(id); }
+    IntSignal &sig;
+    IntSignal::SlotID &id;
+};
+
+// connects another slot to 'sig' when called
+struct Connect {
+    Connect(IntSignal &sig, std::string &str): sig(sig), str(str) { }
+    void operator()(int) { sig.connect(Append(str, 'x')); }
+    IntSignal &sig;
+    std::string &str;
+};
+
+double now() {
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+} // end anonymous namespace
+
+void testOrder() {
+    std::string str;
+    IntSignal sig;
+    for (char c = 'a'; c < 'a' + 10; ++c)
+        sig.connect(Append(str, c));
+    sig.emit(0);
+    check("slots are called in order", str == "abcdefghij");
+}
+
+void testDisconnect() {
+    std::string str;
+    IntSignal sig;
+    IntSignal::SlotID ids[10];
+    for (int i = 0; i < 10; ++i)
+        ids[i] = sig.connect(Append(str, 'a' + i));
+    sig.disconnect(ids[0]);
+    sig.disconnect(ids[5]);
+    sig.disconnect(ids[9]);
+    sig.emit(0);
+    check("disconnect", str == "bcdeghi");
+
+    // 'b' disconnects itself, 'c' disconnects 'h'; both are called
+    // after 'i' now
+    str.clear();
+    sig.disconnect(ids[1]);
+    sig.disconnect(ids[2]);
+    ids[1] = sig.connect(Disconnect(sig, ids[1]));
+    ids[2] = sig.connect(Disconnect(sig, ids[7]));
+    sig.emit(0);
+    check("disconnect while emitting", str == "deghi");
+    str.clear();
+    sig.emit(0);
+    check("... and after emitting", str == "degi");
+
+    str.clear();
+    sig.clear();
+    sig.emit(0);
+    check("clear", str.empty());
+}
+
+void testConnectWhileEmitting() {
+    std::string str;
+    IntSignal sig;
+    IntSignal::SlotID id = sig.connect(Connect(sig, str));
+    sig.emit(0);
+    check("connect while emitting", str == "x");
+    sig.disconnect(id);
+    str.clear();
+    sig.emit(0);
+    check("... and after emitting", str == "x");
+}
+
+void testTracker() {
+    std::string str;
+    IntSignal sig;
+    {
+        FbTk::SignalTracker tracker;
+        tracker.join(sig, Append(str, 'a'));
+        sig.emit(0);
+    }
+    sig.emit(0);
+    check("tracker disconnects", str == "a");
+
+    FbTk::SignalTracker tracker;
+    {
+        IntSignal tmp;
+        tracker.join(tmp, Alive());
+    }
+    check("signal dies before tracker, slot deleted", s_alive == 0);
+
+    // the tracker must have forgotten the dead signal, else leaving
+    // the next one would disconnect from the dead one instead
+    str.clear();
+    IntSignal other;
+    tracker.join(other, Append(str, 'c'));
+    tracker.leaveAll();
+    other.emit(0);
+    check("... tracker still works", str.empty());
+}
+
+// emit cost with 'n' slots connected
+void benchmark(size_t n) {
+    const unsigned long EMITS = 2000000 / n;
+    unsigned long sum = 0;
+    IntSignal sig;
+    // slots are connected over time in a running program, not in one go
+    std::vector<std::string> garbage;
+    for (size_t i = 0; i < n; ++i) {
+        sig.connect(Count(sum));
+        garbage.push_back(std::string(200, 'x'));
+    }
+
+    double start = now();
+    for (unsigned long i = 0; i < EMITS; ++i)
+        sig.emit(1);
+    double elapsed = now() - start;
+
+    printf("emit with %2lu slots: %8.1f ns per emit, %5.1f ns per slot\n",
+           (unsigned long)n, elapsed * 1e9 / EMITS, elapsed * 1e9 / EMITS / n);
+    check("all slots called", sum == EMITS * n);
+}
+
+int main(int argc, char **argv) {
+
+    testOrder();
+    testDisconnect();
+    testConnectWhileEmitting();
+    testTracker();
+
+    // slow, not for 'make check'
+    if (argc > 1 && strcmp(argv[1], "--benchmark") == 0) {
+        benchmark(1);
+        benchmark(4);
+        benchmark(32);
+    }
+
+    return TestUtil::result();
+}
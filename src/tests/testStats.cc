@@ -0,0 +1,99 @@
+// testStats.cc
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "FbTk/Stats.hh"
+#include "TestUtil.hh"
+
+#include <cstdio>
+
+using FbTk::Stats::Histogram;
+using TestUtil::check;
+
+void testBucket() {
+
+    bool exact = true;
+    for (uint64_t value = 0; value < Histogram::SUB_BUCKETS; ++value)
+        exact = exact && Histogram::bucket(value) == value &&
+            Histogram::highest(value) == value;
+    check("small values have buckets of their own", exact);
+
+    check("8 starts the split buckets", Histogram::bucket(8) == 8);
+    check("16 and 17 share a bucket", Histogram::bucket(16) == Histogram::bucket(17));
+    check("... 18 is in the next one", Histogram::bucket(18) == Histogram::bucket(17) + 1);
+
+    // every value is in a bucket whose highest value is at least the value,
+    // at most 1/8 more, and less than the value for the bucket before
+    bool fits = true, precise = true, ordered = true;
+    for (unsigned int shift = 0; shift < 64; ++shift) {
+        const uint64_t power = uint64_t(1) << shift;
+        const uint64_t values[] = { power - 1, power, power + 1, power + power / 3 };
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+            const uint64_t value = values[i];
+            const unsigned int index = Histogram::bucket(value);
+            fits = fits && index < Histogram::BUCKETS &&
+                Histogram::highest(index) >= value;
+            precise = precise &&
+                Histogram::highest(index) - value <= value / Histogram::SUB_BUCKETS;
+            ordered = ordered && (index == 0 || Histogram::highest(index - 1) < value);
+        }
+    }
+    check("values fit their bucket", fits);
+    check("... within 1/8", precise);
+    check("... and not the one before", ordered);
+
+    const unsigned int last = Histogram::bucket(~uint64_t(0));
+    check("the biggest value is in the last bucket",
+          last == Histogram::BUCKETS - 1 && Histogram::highest(last) == ~uint64_t(0));
+}
+
+void testPercentile() {
+
+    Histogram h;
+    check("empty", h.count() == 0 && h.percentile(50) == 0 && h.max() == 0);
+
+    h.add(1234);
+    check("one value", h.percentile(1) == 1234 && h.percentile(100) == 1234);
+
+    h.reset();
+    for (uint64_t value = 1; value <= 1000; ++value)
+        h.add(value);
+    check("count, sum and max", h.count() == 1000 && h.sum() == 500500 && h.max() == 1000);
+
+    const uint64_t p50 = h.percentile(50), p90 = h.percentile(90), p99 = h.percentile(99);
+    printf("p50 %lu, p90 %lu, p99 %lu\n",
+           (unsigned long)p50, (unsigned long)p90, (unsigned long)p99);
+    check("p50 of 1..1000", p50 >= 500 && p50 <= 500 + 500 / 8);
+    check("p90 of 1..1000", p90 >= 900 && p90 <= 900 + 900 / 8);
+    check("p99 of 1..1000", p99 >= 990 && p99 <= 1000);
+    check("p100 is the max", h.percentile(100) == 1000);
+
+    h.add(1000000);
+    check("an outlier doesn't move p50", h.percentile(50) == p50);
+    check("... but the max", h.percentile(100) == 1000000);
+}
+
+int main(int argc, char **argv) {
+
+    testBucket();
+    testPercentile();
+
+    return TestUtil::result();
+}
@@ -0,0 +1,343 @@
+// AppsIndex.cc
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "AppsIndex.hh"
+
+#ifdef HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // HAVE_SYS_INOTIFY_H
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#ifdef HAVE_CSTDLIB
+  #include <cstdlib>
+#else
+  #include <stdlib.h>
+#endif
+
+using std::string;
+using std::vector;
+
+namespace {
+
+/// number of directory entries to look at per call of AppsIndex::work()
+const size_t WORK_CHUNK = 64;
+
+const char CACHE_HEADER[] = "# fbrun apps cache, version 1";
+
+/// the name of the app in 'command', "/usr/bin/xterm -e top" -> "xterm"
+string appName(const string &command) {
+    string::size_type end = command.find_first_of(" \t");
+    string path = command.substr(0, end);
+    string::size_type slash = path.rfind('/');
+    if (slash != string::npos)
+        return path.substr(slash + 1);
+    return path;
+}
+
+class RankCompare {
+public:
+    explicit RankCompare(const std::map<string, double> &rank) : m_rank(rank) { }
+    bool operator()(const string &a, const string &b) const {
+        double ra = rankOf(a);
+        double rb = rankOf(b);
+        if (ra != rb)
+            return ra > rb;
+        return a < b;
+    }
+private:
+    double rankOf(const string &app) const {
+        std::map<string, double>::const_iterator it = m_rank.find(app);
+        return it != m_rank.end() ? it->second : 0.0;
+    }
+    const std::map<string, double> &m_rank;
+};
+
+} // end anonymous namespace
+
+AppsIndex::AppsIndex():
+    m_apps_dirty(false),
+    m_cache_dirty(false),
+    m_scan_dir(0),
+    m_scan_ctime(0),
+    m_inotify_fd(-1) {
+
+#ifdef HAVE_SYS_INOTIFY_H
+    m_inotify_fd = inotify_init();
+    if (m_inotify_fd != -1)
+        fcntl(m_inotify_fd, F_SETFL, fcntl(m_inotify_fd, F_GETFL) | O_NONBLOCK);
+#endif // HAVE_SYS_INOTIFY_H
+}
+
+AppsIndex::~AppsIndex() {
+#ifdef HAVE_SYS_INOTIFY_H
+    if (m_inotify_fd != -1)
+        close(m_inotify_fd);
+#endif // HAVE_SYS_INOTIFY_H
+}
+
+void AppsIndex::setPath(const string &path) {
+
+    std::istringstream in(path);
+    string name;
+
+    while (getline(in, name, ':')) {
+        if (name.empty())
+            continue;
+
+        size_t i;
+        for (i = 0; i < m_dirs.size(); ++i) {
+            if (m_dirs[i].name == name)
+                break;
+        }
+        if (i != m_dirs.size())
+            continue;
+
+        Dir dir;
+        dir.name = name;
+        dir.ctime = 0;
+        dir.state = DIR_NEW;
+        dir.watch = -1;
+        m_dirs.push_back(dir);
+    }
+}
+
+bool AppsIndex::loadCache(const string &filename) {
+
+    m_cache_file = filename;
+
+    std::ifstream infile(filename.c_str());
+    if (!infile)
+        return false;
+
+    string line;
+    if (!getline(infile, line) || line != CACHE_HEADER)
+        return false;
+
+    // format:
+    //   <ctime> <directory>
+    //    <app>
+    //    <app>
+    Dir *dir = 0;
+    while (getline(infile, line)) {
+        if (line.empty())
+            continue;
+
+        if (line[0] == ' ') {
+            if (dir)
+                dir->apps.push_back(line.substr(1));
+            continue;
+        }
+
+        dir = 0;
+        string::size_type space = line.find(' ');
+        if (space == string::npos)
+            continue;
+
+        string name = line.substr(space + 1);
+        for (size_t i = 0; i < m_dirs.size(); ++i) {
+            if (m_dirs[i].name == name && m_dirs[i].state == DIR_NEW) {
+                dir = &m_dirs[i];
+                dir->ctime = strtol(line.c_str(), 0, 10);
+                dir->state = DIR_CACHED;
+                dir->apps.clear();
+                break;
+            }
+        }
+    }
+
+    m_apps_dirty = true;
+    return true;
+}
+
+bool AppsIndex::saveCache() {
+
+    if (!m_cache_dirty || m_cache_file.empty())
+        return true;
+
+    std::ofstream outfile(m_cache_file.c_str());
+    if (!outfile)
+        return false;
+
+    outfile << CACHE_HEADER << "\n";
+    for (size_t i = 0; i < m_dirs.size(); ++i) {
+        const Dir &dir = m_dirs[i];
+        if (dir.state != DIR_VALID && dir.state != DIR_CACHED)
+            continue;
+
+        outfile << dir.ctime << " " << dir.name << "\n";
+        for (size_t j = 0; j < dir.apps.size(); ++j)
+            outfile << " " << dir.apps[j] << "\n";
+    }
+
+    m_cache_dirty = false;
+    return outfile.good();
+}
+
+bool AppsIndex::work() {
+
+    checkChanges();
+
+    // continue reading the current directory
+    if (m_scan_dir < m_dirs.size() && m_scan.name() == m_dirs[m_scan_dir].name) {
+
+        Dir &dir = m_dirs[m_scan_dir];
+        const string base = dir.name + (*dir.name.rbegin() != '/' ? "/" : "");
+        size_t n;
+        struct dirent *entry = 0;
+
+        for (n = 0; n < WORK_CHUNK && (entry = m_scan.read()) != 0; ++n) {
+            string filename = entry->d_name;
+            if (filename == "." || filename == "..")
+                continue;
+            if (FbTk::FileUtil::isExecutableFile((base + filename).c_str()))
+                m_scan_apps.push_back(filename);
+        }
+
+        if (entry != 0)
+            return true;
+
+        m_scan.close();
+        std::sort(m_scan_apps.begin(), m_scan_apps.end());
+        dir.apps.swap(m_scan_apps);
+        m_scan_apps.clear();
+        // changed while we were reading it? then it is read again
+        if (dir.state != DIR_STALE) {
+            dir.state = DIR_VALID;
+            dir.ctime = m_scan_ctime;
+        }
+        m_apps_dirty = true;
+        m_cache_dirty = true;
+        return true;
+    }
+
+    for (m_scan_dir = 0; m_scan_dir < m_dirs.size(); ++m_scan_dir) {
+        if (m_dirs[m_scan_dir].state != DIR_VALID)
+            break;
+    }
+    if (m_scan_dir == m_dirs.size())
+        return false;
+
+    Dir &dir = m_dirs[m_scan_dir];
+    // watch first, so changes while reading the directory are noticed
+    watch(dir);
+
+    m_scan_ctime = FbTk::FileUtil::getLastStatusChangeTimestamp(dir.name.c_str());
+    if (dir.state == DIR_CACHED && dir.ctime == m_scan_ctime) {
+        dir.state = DIR_VALID;
+        return true;
+    }
+
+    dir.state = DIR_NEW;
+    if (m_scan_ctime == (time_t)-1 || !m_scan.open(dir.name.c_str())) {
+        // not there (anymore)
+        if (!dir.apps.empty())
+            m_apps_dirty = true;
+        dir.apps.clear();
+        dir.state = DIR_VALID;
+        dir.ctime = m_scan_ctime;
+        m_cache_dirty = true;
+    }
+
+    return true;
+}
+
+void AppsIndex::finish() {
+    while (work())
+        ;
+}
+
+void AppsIndex::rankBy(const vector<string> &history) {
+
+    // each use counts, recent ones count more
+    m_rank.clear();
+    const size_t n = history.size();
+    for (size_t i = 0; i < n; ++i) {
+        const size_t age = n - i - 1;
+        m_rank[appName(history[i])] += 10.0 / (10.0 + age);
+    }
+}
+
+void AppsIndex::find(const string &prefix, vector<string> &apps) {
+
+    finish();
+    updateApps();
+
+    vector<string>::const_iterator it =
+        std::lower_bound(m_apps.begin(), m_apps.end(), prefix);
+    for (; it != m_apps.end() && it->compare(0, prefix.size(), prefix) == 0; ++it)
+        apps.push_back(*it);
+
+    if (!m_rank.empty())
+        std::stable_sort(apps.begin(), apps.end(), RankCompare(m_rank));
+}
+
+void AppsIndex::checkChanges() {
+#ifdef HAVE_SYS_INOTIFY_H
+    if (m_inotify_fd == -1)
+        return;
+
+    char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    ssize_t len;
+    while ((len = read(m_inotify_fd, buf, sizeof(buf))) > 0) {
+        for (char *p = buf; p < buf + len; ) {
+            const struct inotify_event *event =
+                reinterpret_cast<const struct inotify_event *>(p);
+            for (size_t i = 0; i < m_dirs.size(); ++i) {
+                if (m_dirs[i].watch == event->wd) {
+                    m_dirs[i].state = DIR_STALE;
+                    break;
+                }
+            }
+            p += sizeof(struct inotify_event) + event->len;
+        }
+    }
+#endif // HAVE_SYS_INOTIFY_H
+}
+
+void AppsIndex::watch(Dir &dir) {
+#ifdef HAVE_SYS_INOTIFY_H
+    if (m_inotify_fd == -1 || dir.watch != -1)
+        return;
+
+    dir.watch = inotify_add_watch(m_inotify_fd, dir.name.c_str(),
+            IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+            IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF);
+#endif // HAVE_SYS_INOTIFY_H
+}
+
+void AppsIndex::updateApps() {
+
+    if (!m_apps_dirty)
+        return;
+
+    m_apps.clear();
+    for (size_t i = 0; i < m_dirs.size(); ++i)
+        m_apps.insert(m_apps.end(), m_dirs[i].apps.begin(), m_dirs[i].apps.end());
+
+    std::sort(m_apps.begin(), m_apps.end());
+    m_apps.erase(std::unique(m_apps.begin(), m_apps.end()), m_apps.end());
+    m_apps_dirty = false;
+}
@@ -0,0 +1,115 @@
+// AppsIndex.hh
+// Copyright (c) 2026 Fluxbox Team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef APPSINDEX_HH
+#define APPSINDEX_HH
+
+#include "FbTk/FileUtil.hh"
+#include "FbTk/NotCopyable.hh"
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+   Index of the executables in a list of directories (usually $PATH).
+
+   The index is built in small steps via work(), so it can be done while
+   the application waits for input. The content of each directory is kept
+   in a cache file together with the status change time of the directory;
+   on the next start only directories which changed since then are read
+   again. While running, changes to the directories are picked up via
+   inotify, if available.
+*/
+class AppsIndex: private FbTk::NotCopyable {
+public:
+    AppsIndex();
+    ~AppsIndex();
+
+    /// sets the directories to index, separated by ':' like $PATH
+    void setPath(const std::string &path);
+
+    /**
+       loads the index from a cache file; directories which changed
+       since the cache was written are read again by work().
+       @return true on success, else false
+    */
+    bool loadCache(const std::string &filename);
+    /// writes the index to the cache file, if it changed
+    bool saveCache();
+
+    /**
+       does the next bit of indexing.
+       @return true if there is more to do, else false
+    */
+    bool work();
+    /// does all the indexing left
+    void finish();
+
+    /**
+       ranks the apps by how often and how recently they were used
+       @param history command history, oldest command first
+    */
+    void rankBy(const std::vector<std::string> &history);
+
+    /**
+       finds all apps starting with 'prefix'; sorted by rank if rankBy()
+       was used, else alphabetically.
+    */
+    void find(const std::string &prefix, std::vector<std::string> &apps);
+
+private:
+    enum DirState {
+        DIR_NEW,     ///< nothing known about the directory
+        DIR_CACHED,  ///< content from the cache file, might be outdated
+        DIR_STALE,   ///< content is known to be outdated
+        DIR_VALID    ///< content is up to date
+    };
+
+    struct Dir {
+        std::string name;
+        time_t ctime;
+        DirState state;
+        int watch; ///< inotify watch descriptor
+        std::vector<std::string> apps;
+    };
+
+    void checkChanges();
+    void watch(Dir &dir);
+    void updateApps();
+
+    std::vector<Dir> m_dirs;
+    std::vector<std::string> m_apps; ///< sorted union of all apps in m_dirs
+    bool m_apps_dirty;  ///< m_apps needs to be rebuild
+    bool m_cache_dirty; ///< cache file needs to be written
+    std::string m_cache_file;
+
+    size_t m_scan_dir; ///< index of the directory currently read
+    FbTk::Directory m_scan;
+    std::vector<std::string> m_scan_apps;
+    time_t m_scan_ctime;
+
+    std::map<std::string, double> m_rank;
+
+    int m_inotify_fd;
+};
+
+#endif // APPSINDEX_HH
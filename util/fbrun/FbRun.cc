@@ -66,7 +66,10 @@ FbRun::FbRun(int x, int y, size_t width):
     m_end(false),
     m_current_history_item(0),
     m_last_completion_prefix(""),
+    m_apps_valid(false),
     m_current_apps_item(0),
+    m_rank_apps(false),
+    m_apps_ranked(false),
     m_cursor(XCreateFontCursor(FbTk::App::instance()->display(), XC_xterm)) {
 
     setGC(m_gc.gc());
@@ -102,11 +105,15 @@ FbRun::FbRun(int x, int y, size_t width):
         XSetWMHints(m_display, window(), &wmhints);
     }
 
+    char* tmp_path = getenv("PATH");
+    if (tmp_path)
+        m_apps_index.setPath(tmp_path);
 }
 
 
 FbRun::~FbRun() {
     hide();
+    m_apps_index.saveCache();
 }
 
 void FbRun::run(const std::string &command) {
@@ -203,6 +210,13 @@ bool FbRun::loadHistory(const char *filename) {
     return true;
 }
 
+bool FbRun::loadAppsCache(const char *filename) {
+    if (filename == 0)
+        return false;
+
+    return m_apps_index.loadCache(filename);
+}
+
 bool FbRun::loadFont(const string &fontname) {
     if (!m_font.load(fontname.c_str()))
         return false;
@@ -383,76 +397,56 @@ void FbRun::tabCompleteHistory() {
 
 void FbRun::tabCompleteApps() {
 
-    static bool first_run= true;
     if (m_last_completion_prefix.empty())
         m_last_completion_prefix = text().substr(0, textStartPos() + cursorPosition());
     string prefix = m_last_completion_prefix;
-    FbTk::Directory dir;
 
     bool add_dirs= false;
     bool changed_prefix= false;
 
+    if(!prefix.empty() &&
+        string("/.~").find_first_of(prefix[0]) != string::npos) {
+        add_dirs= true;
+    }
+
     // (re)build m_apps-container
-    if (first_run || m_last_completion_prefix != prefix) {
-        first_run= false;
+    if (!m_apps_valid || m_apps_prefix != prefix) {
 
-        string path;
+        m_apps.clear();
 
-        if(!prefix.empty() &&
-            string("/.~").find_first_of(prefix[0]) != string::npos) {
+        if (add_dirs) {
             size_t rseparator= prefix.find_last_of("/");
-            path= prefix.substr(0, rseparator + 1) +  ":";
-            add_dirs= true;
-        } else {
-            char* tmp_path = getenv("PATH");
-            if (tmp_path)
-                path = tmp_path;
-        }
-        m_apps.clear();
+            FbTk::Directory dir(prefix.substr(0, rseparator + 1).c_str());
+            int n= dir.entries();
+            while (n-- > 0) {
+                string filename= dir.readFilename();
+                string fncomplete= dir.name() +
+                                   (*dir.name().rbegin() != '/' ? "/" : "") +
+                                   filename;
+
+                if (filename == ".." || filename == "." ||
+                    fncomplete.substr(0, prefix.size()) != prefix) {
+                    continue;
+                }
 
-        unsigned int l;
-        unsigned int r;
-
-        for(l= 0, r= 0; r < path.size(); r++) {
-            if ((path[r]==':' || r == path.size() - 1) && r - l > 0) {
-                string filename;
-                string fncomplete;
-                dir.open(path.substr(l, r - l).c_str());
-                int n= dir.entries();
-                if (n >= 0) {
-                    while(n--) {
-                        filename= dir.readFilename();
-                        fncomplete= dir.name() +
-                                    (*dir.name().rbegin() != '/' ? "/" : "") +
-                                    filename;
-
-                        // directories in dirmode ?
-                        if (add_dirs && FbTk::FileUtil::isDirectory(fncomplete.c_str()) &&
-                            filename != ".." && filename != ".") {
-                            m_apps.push_back(fncomplete);
-                        // executables in dirmode ?
-                        } else if (add_dirs && FbTk::FileUtil::isRegularFile(fncomplete.c_str()) &&
-                                   FbTk::FileUtil::isExecutable(fncomplete.c_str()) &&
-                                   (prefix == "" ||
-                                    fncomplete.substr(0, prefix.size()) == prefix)) {
-                            m_apps.push_back(fncomplete);
-                        // executables in $PATH ?
-                        } else if (FbTk::FileUtil::isRegularFile(fncomplete.c_str()) &&
-                                   FbTk::FileUtil::isExecutable(fncomplete.c_str()) &&
-                                   (prefix == "" ||
-                                    filename.substr(0, prefix.size()) == prefix)) {
-                            m_apps.push_back(filename);
-                        }
-                    }
+                // directories or executables in dirmode
+                if (FbTk::FileUtil::isDirectory(fncomplete.c_str()) ||
+                    FbTk::FileUtil::isExecutableFile(fncomplete.c_str())) {
+                    m_apps.push_back(fncomplete);
                 }
-                l= r + 1;
-                dir.close();
             }
+            sort(m_apps.begin(), m_apps.end());
+        } else {
+            // executables in $PATH
+            if (m_rank_apps && !m_apps_ranked) {
+                m_apps_index.rankBy(m_history);
+                m_apps_ranked = true;
+            }
+            m_apps_index.find(prefix, m_apps);
         }
-        sort(m_apps.begin(), m_apps.end());
-        unique(m_apps.begin(), m_apps.end());
 
-        m_last_completion_prefix = prefix;
+        m_apps_prefix = prefix;
+        m_apps_valid = true;
         changed_prefix= true;
         m_current_apps_item= 0;
     }
@@ -29,6 +29,8 @@
 #include "FbTk/GContext.hh"
 #include "FbTk/FbPixmap.hh"
 
+#include "AppsIndex.hh"
+
 #include <string>
 #include <vector>
 
@@ -57,6 +59,20 @@ public:
        @return true on success, else false
     */
     bool loadHistory(const char *filename);
+    /**
+       loads the cache of the apps in $PATH, which is used for tab
+       completion and updated when fbrun is done.
+       @return true on success, else false
+    */
+    bool loadAppsCache(const char *filename);
+    /// rank apps found by tab completion by the command history
+    void setRankApps(bool rank) { m_rank_apps = rank; }
+    /**
+       does the next bit of indexing the apps in $PATH, meant to be
+       called while waiting for input.
+       @return true if there is more to do, else false
+    */
+    bool indexApps() { return m_apps_index.work(); }
     /**
        @name events
     */
@@ -96,8 +112,13 @@ private:
     
     typedef std::vector<std::string> AppsContainer;
     typedef AppsContainer::iterator AppsContainerIt;
-    AppsContainer m_apps; ///< holds all apps in $PATH
+    AppsContainer m_apps; ///< holds the apps matching m_apps_prefix
+    std::string m_apps_prefix; ///< prefix m_apps was collected for
+    bool m_apps_valid; ///< m_apps was collected at all
     size_t m_current_apps_item; ///< holds current position in apps-history
+    AppsIndex m_apps_index; ///< all apps in $PATH
+    bool m_rank_apps; ///< rank apps by the history
+    bool m_apps_ranked; ///< m_apps_index got the history already
     
     Cursor m_cursor;
 
@@ -21,6 +21,7 @@
 
 #include "FbRun.hh"
 #include "FbTk/App.hh"
+#include "FbTk/EventManager.hh"
 #include "FbTk/StringUtil.hh"
 #include "FbTk/Color.hh"
 
@@ -65,6 +66,8 @@ void showUsage(const char *progname) {
         "   -bg [color name]            Background color"<<endl<<
         "   -na                         Disable antialias"<<endl<<
         "   -hf [history file]          History file to load (default ~/.fluxbox/fbrun_history)"<<endl<<
+        "   -cf [cache file]            Cache file for the apps in $PATH (default ~/.fluxbox/fbrun_cache)"<<endl<<
+        "   -frecency                   Complete often and recently used apps first"<<endl<<
         "   -help                       Show this help"<<endl<<endl<<
         "Example: fbrun -fg black -bg white -text xterm -title \"run xterm\""<<endl;
 }
@@ -76,6 +79,7 @@ int main(int argc, char **argv) {
     bool set_pos = false; // set position
     bool near_mouse = false; // popup near mouse
     bool print = false;
+    bool frecency = false;
     string fontname; // font name
     string title("Run program"); // default title
     string text;         // default input text
@@ -83,6 +87,7 @@ int main(int argc, char **argv) {
     string background("white");   // text background color
     string display_name; // name of the display connection
     string history_file("~/.fluxbox/fbrun_history"); // command history file
+    string cache_file("~/.fluxbox/fbrun_cache"); // apps cache file
     // parse arguments
     for (int i=1; i<argc; i++) {
         string arg = argv[i];
@@ -115,6 +120,10 @@ int main(int argc, char **argv) {
             background = argv[++i];
         } else if (strcmp(argv[i], "-hf") == 0 && i+1 < argc) {
             history_file = argv[++i];
+        } else if (strcmp(argv[i], "-cf") == 0 && i+1 < argc) {
+            cache_file = argv[++i];
+        } else if (arg == "-frecency" || arg == "--frecency") {
+            frecency = true;
         } else if (arg == "-h" || arg == "-help" || arg == "--help") {
             showUsage(argv[0]);
             exit(0);
@@ -132,6 +141,7 @@ int main(int argc, char **argv) {
         FbRun fbrun;
 
         fbrun.setPrint(print);
+        fbrun.setRankApps(frecency);
 
         if (fontname.size() != 0) {
             if (!fbrun.loadFont(fontname.c_str())) {
@@ -157,6 +167,9 @@ int main(int argc, char **argv) {
         if (!fbrun.loadHistory(expanded_filename.c_str()))
             cerr<<"FbRun Warning: Failed to load history file: "<<expanded_filename<<endl;
 
+        // a missing cache is no problem, it's written when we are done
+        fbrun.loadAppsCache(FbTk::StringUtil::expandFilename(cache_file).c_str());
+
         fbrun.setTitle(title);
         fbrun.setText(text);
 
@@ -221,7 +234,16 @@ int main(int argc, char **argv) {
 
         fbrun.show();
 
-        application.eventLoop();
+        // index the apps in $PATH for tab completion while the user
+        // is typing
+        Display* dpy = FbTk::App::instance()->display();
+        XEvent ev;
+        while (!fbrun.end()) {
+            if (XPending(dpy) == 0 && fbrun.indexApps())
+                continue;
+            XNextEvent(dpy, &ev);
+            FbTk::EventManager::instance()->handleEvent(ev);
+        }
 
     } catch (string & errstr) {
         cerr<<"Error: "<<errstr<<endl;
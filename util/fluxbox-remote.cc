@@ -26,6 +26,13 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+#ifdef HAVE_SYS_UN_H
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif // HAVE_SYS_UN_H
+
 
 bool g_gotError = false;
 static int HandleIPCError(Display *disp, XErrorEvent*ptr)
@@ -37,6 +44,84 @@ static int HandleIPCError(Display *disp, XErrorEvent*ptr)
 
 typedef int (*xerror_cb_t)(Display*,XErrorEvent*);
 
+#ifdef HAVE_SYS_UN_H
+// sends all commands in one go over the IPC socket of fluxbox (see
+// session.ipcSocket) and prints their output. returns -1 if the socket
+// can't be used, else the exit code.
+static int sendToSocket(const char* path, int ncmds, char** cmds) {
+
+    struct sockaddr_un addr;
+    int         fd;
+    int         rc = EXIT_SUCCESS;
+    int         i;
+    char        buf[4096];
+    ssize_t     len;
+    char*       replies = NULL;
+    size_t      size = 0;
+    char*       line;
+    char*       end;
+
+    if (strlen(path) >= sizeof(addr.sun_path))
+        return -1;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1)
+        return -1;
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == -1) {
+        close(fd);
+        return -1;
+    }
+
+    for (i = 0; i < ncmds; i++) {
+        if (write(fd, cmds[i], strlen(cmds[i])) == -1 || write(fd, "\n", 1) == -1) {
+            close(fd);
+            return EXIT_FAILURE;
+        }
+    }
+    // tells fluxbox that this was all
+    shutdown(fd, SHUT_WR);
+
+    while ((len = read(fd, buf, sizeof(buf))) > 0) {
+        replies = (char*)realloc(replies, size + len + 1);
+        memcpy(replies + size, buf, len);
+        size += len;
+    }
+    close(fd);
+
+    if (!replies)
+        return EXIT_FAILURE;
+    replies[size] = 0;
+
+    // <n> data <text>, <n> ok or <n> error <reason>
+    for (line = replies; *line; line = end + 1) {
+        end = strchr(line, '\n');
+        if (!end)
+            break;
+        *end = 0;
+
+        i = atoi(line);
+        line = strchr(line, ' ');
+        if (!line)
+            continue;
+        line++;
+        if (strncmp(line, "data ", 5) == 0) {
+            printf("%s\n", line + 5);
+        } else if (strncmp(line, "error ", 6) == 0) {
+            fprintf(stderr, "fluxbox-remote: %s: %s\n",
+                    (i > 0 && i <= ncmds) ? cmds[i - 1] : "?", line + 6);
+            rc = EXIT_FAILURE;
+        }
+    }
+
+    free(replies);
+    return rc;
+}
+#endif // HAVE_SYS_UN_H
+
 
 int main(int argc, char **argv) {
 
@@ -49,10 +134,21 @@ int main(int argc, char **argv) {
     char*       cmd;
 
     if (argc <= 1) {
-        printf("fluxbox-remote <fluxbox-command>\n");
+        printf("fluxbox-remote <fluxbox-command> [<fluxbox-command> ...]\n");
         return EXIT_SUCCESS;
     }
 
+    cmd = argv[1];
+
+#ifdef HAVE_SYS_UN_H
+    const char* socket_path = getenv("FLUXBOX_IPC_SOCKET");
+    if (socket_path && *socket_path && strcmp(cmd, "result") != 0) {
+        rc = sendToSocket(socket_path, argc - 1, argv + 1);
+        if (rc != -1)
+            return rc;
+    }
+#endif // HAVE_SYS_UN_H
+
     disp = XOpenDisplay(NULL);
     if (!disp) {
         perror("error, can't open display.");
@@ -60,7 +156,6 @@ int main(int argc, char **argv) {
         return rc;
     }
 
-    cmd = argv[1];
     atom_fbcmd = XInternAtom(disp, "_FLUXBOX_ACTION", False);
     atom_result = XInternAtom(disp, "_FLUXBOX_ACTION_RESULT", False);
     root = DefaultRootWindow(disp);
@@ -73,17 +168,24 @@ int main(int argc, char **argv) {
     if (strcmp(cmd, "result") == 0) {
         XTextProperty text_prop;
         if (XGetTextProperty(disp, root, &text_prop, atom_result) != 0
-            && text_prop.value > 0
+            && text_prop.value != 0
             && text_prop.nitems > 0) {
 
             printf("%s", text_prop.value);
             XFree(text_prop.value);
         }
     } else {
+        // the property holds one command at a time, a second one would
+        // replace the first before fluxbox got to read it
         XChangeProperty(disp, root, atom_fbcmd,
                               XA_STRING, 8, PropModeReplace,
                               (unsigned char *)cmd, strlen(cmd));
         XSync(disp, false);
+        if (argc > 2) {
+            fprintf(stderr, "fluxbox-remote: only \"%s\" was sent, "
+                    "several commands need FLUXBOX_IPC_SOCKET\n", cmd);
+            g_gotError = true;
+        }
     }
 
     rc = (g_gotError ? EXIT_FAILURE : EXIT_SUCCESS);